@@ -0,0 +1,209 @@
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BatchRunner.h"
+#include "CrossCoords.h"
+#include "CrossSweep.h"
+#include "EdgeBatch.h"
+#include "MoveParser.h"
+#include "Moves.h"
+
+namespace {
+
+    // lines are handed out in chunks so the queue lock isn't hit per scramble
+    constexpr std::size_t kChunkLines = 256;
+
+    struct Chunk {
+	std::size_t seq;
+	std::vector<std::string> lines;
+    };
+
+    /*
+     * All pipeline state behind one lock. inFlight counts chunks that were
+     * read but not written yet, which bounds memory when the writer is slow.
+     */
+    struct Pipeline {
+	std::mutex mtx;
+	std::condition_variable workReady;
+	std::condition_variable doneReady;
+	std::condition_variable spaceReady;
+	std::deque<Chunk> work;
+	std::map<std::size_t, std::string> done;
+	std::size_t inFlight = 0;
+	std::size_t maxInFlight = 0;
+	bool readerDone = false;
+	std::size_t chunksRead = 0;
+	bool compact = false;
+	OutputFormat format = OutputFormat::TSV;
+    };
+
+    void formatLine(const std::string& scramble, std::string& out, bool compact, OutputFormat fmt){
+	// only cross data is needed, so the scramble goes straight to the edge coordinates
+	std::uint8_t codes[MAX_SCRAMBLE_MOVES];
+	ParseResult parsed = parseMoves(scramble, codes, MAX_SCRAMBLE_MOVES);
+	if(!parsed.ok()){
+	    appendError(out, fmt, scramble, describeError(parsed, scramble));
+	    return;
+	}
+	cross::EdgeLocations loc = cross::SOLVED_EDGES;
+	cross::applyMoves(loc, codes, parsed.count);
+
+	std::array<RowView, 24> rows;
+	if(compact){
+	    SweepSequences seqs = sweepOrientationsCompact(loc);
+	    std::array<std::string, 24> text;
+	    for(int i = 0; i < 24; i++){
+		text[i] = moves::toString(seqs[i]);
+		rows[i] = {text[i], i, seqs[i].length, -1};
+	    }
+	    appendRecord(out, fmt, scramble, rows.data(), rows.size());
+	    return;
+	}
+	SweepResult sols = sweepOrientations(loc);
+	for(int i = 0; i < 24; i++) rows[i] = {sols[i], i, numMoves(sols[i]), -1};
+	appendRecord(out, fmt, scramble, rows.data(), rows.size());
+    }
+
+    /*
+     * Full-table chunks: every line is parsed into edge coordinates first, then
+     * the whole chunk goes through the SIMD batch kernel one orientation at a
+     * time, and the lines are formatted from those views.
+     */
+    void formatChunk(const std::vector<std::string>& lines, std::string& out, bool compact, OutputFormat fmt){
+	if(compact){
+	    for(const std::string& line : lines) formatLine(line, out, compact, fmt);
+	    return;
+	}
+	std::size_t n = lines.size();
+	cross::EdgeBatch batch(n);
+	std::vector<bool> good(n);
+	std::uint8_t codes[MAX_SCRAMBLE_MOVES];
+	for(std::size_t i = 0; i < n; i++){
+	    ParseResult parsed = parseMoves(lines[i], codes, MAX_SCRAMBLE_MOVES);
+	    good[i] = parsed.ok();
+	    if(!good[i]) continue;
+	    cross::EdgeLocations loc = cross::SOLVED_EDGES;
+	    cross::applyMoves(loc, codes, parsed.count);
+	    batch.set(i, loc);
+	}
+	std::vector<std::string_view> sols(24 * n);	//[orientation][line]
+	for(int o = 0; o < 24; o++) batch.solutions(o, sols.data() + o * n);
+
+	std::array<RowView, 24> rows;
+	for(std::size_t i = 0; i < n; i++){
+	    if(!good[i]){
+		formatLine(lines[i], out, compact, fmt);
+		continue;
+	    }
+	    for(int o = 0; o < 24; o++){
+		std::string_view s = sols[o * n + i];
+		rows[o] = {s, o, numMoves(s), -1};
+	    }
+	    appendRecord(out, fmt, lines[i], rows.data(), rows.size());
+	}
+    }
+
+    void worker(Pipeline& p){
+	for(;;){
+	    Chunk chunk;
+	    {
+		std::unique_lock<std::mutex> lock(p.mtx);
+		p.workReady.wait(lock, [&]{ return !p.work.empty() || p.readerDone; });
+		if(p.work.empty()) return;
+		chunk = std::move(p.work.front());
+		p.work.pop_front();
+	    }
+
+	    std::string text;
+	    formatChunk(chunk.lines, text, p.compact, p.format);
+
+	    {
+		std::lock_guard<std::mutex> lock(p.mtx);
+		p.done.emplace(chunk.seq, std::move(text));
+	    }
+	    p.doneReady.notify_one();
+	}
+    }
+
+    void writer(Pipeline& p, std::ostream& out){
+	std::size_t next = 0;
+	for(;;){
+	    std::string text;
+	    {
+		std::unique_lock<std::mutex> lock(p.mtx);
+		p.doneReady.wait(lock, [&]{
+		    return (!p.done.empty() && p.done.begin()->first == next) || (p.readerDone && next == p.chunksRead);
+		});
+		if(p.done.empty() || p.done.begin()->first != next) return;
+		text = std::move(p.done.begin()->second);
+		p.done.erase(p.done.begin());
+		--p.inFlight;
+	    }
+	    p.spaceReady.notify_one();
+	    out.write(text.data(), static_cast<std::streamsize>(text.size()));
+	    ++next;
+	}
+    }
+}
+
+BatchStats runBatch(std::istream& in, std::ostream& out, unsigned threads, bool compact, OutputFormat fmt){
+    if(threads == 0) threads = 1;
+    if(fmt == OutputFormat::CSV) out << csvHeader();
+
+    Pipeline p;
+    p.compact = compact;
+    p.format = fmt;
+    p.maxInFlight = 4 * static_cast<std::size_t>(threads);
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> pool;
+    for(unsigned i = 0; i < threads; i++){
+	pool.emplace_back(worker, std::ref(p));
+    }
+    std::thread writerThread(writer, std::ref(p), std::ref(out));
+
+    // reader runs on the calling thread
+    std::size_t total = 0;
+    std::string line;
+    Chunk chunk{0, {}};
+    auto flush = [&](){
+	std::unique_lock<std::mutex> lock(p.mtx);
+	p.spaceReady.wait(lock, [&]{ return p.inFlight < p.maxInFlight; });
+	++p.inFlight;
+	++p.chunksRead;
+	p.work.push_back(std::move(chunk));
+	lock.unlock();
+	p.workReady.notify_one();
+	chunk = Chunk{p.chunksRead, {}};
+    };
+
+    while(std::getline(in, line)){
+	if(!line.empty() && line.back() == '\r') line.pop_back();
+	chunk.lines.push_back(std::move(line));
+	++total;
+	if(chunk.lines.size() == kChunkLines) flush();
+    }
+    if(!chunk.lines.empty()) flush();
+
+    {
+	std::lock_guard<std::mutex> lock(p.mtx);
+	p.readerDone = true;
+    }
+    p.workReady.notify_all();
+    p.doneReady.notify_all();
+
+    for(std::thread& t : pool) t.join();
+    writerThread.join();
+    out.flush();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return BatchStats{total, elapsed.count(), threads};
+}
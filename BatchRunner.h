@@ -0,0 +1,29 @@
+#ifndef BATCH_RUNNER_H
+#define BATCH_RUNNER_H
+
+#include <cstddef>
+#include <iostream>
+#include "OutputFormat.h"
+
+struct BatchStats {
+    std::size_t scrambles = 0;
+    double seconds = 0.0;
+    unsigned threads = 0;
+};
+
+/*
+ * Streams scrambles (one per line) from `in` through a
+ * reader -> worker pool -> ordered writer pipeline.
+ * Every input line produces exactly one output line, in input order:
+ *
+ *   <scramble>\t<best move count>\t<solution 0>\t...\t<solution 23>
+ *
+ * with solutions in cross::ORIENTATIONS order. A line that doesn't parse
+ * comes out as <scramble>\terror\t<column and reason>. `compact` answers from the
+ * 4-bit distance table instead of the full one (same solutions). Other
+ * formats write the same records as JSON lines, CSV rows or compact lines
+ * (see OutputFormat.h), TEXT is taken as TSV.
+ */
+BatchStats runBatch(std::istream& in, std::ostream& out, unsigned threads, bool compact = false, OutputFormat fmt = OutputFormat::TSV);
+
+#endif
@@ -0,0 +1,47 @@
+#include "CompactCrossTable.h"
+#include "CrossCoords.h"
+#include "CrossDistance.h"
+#include "CrossTableCompact.generated.hpp"
+
+static_assert(cross_table_compact::kBase == cross::BASE, "compact table was generated for another index layout");
+static_assert(sizeof(cross_table_compact::kDist) == (cross::STATES + 1) / 2, "compact table has the wrong size");
+
+std::uint8_t cross::compactDistance(std::size_t idx) noexcept {
+    std::uint8_t b = cross_table_compact::kDist[idx >> 1];
+    return (idx & 1) ? b >> 4 : b & 0xF;
+}
+
+moves::Sequence cross::compactSolution(const std::array<int, 4>& pos) noexcept {
+    const MoveTable& next = edgeMoveTable();
+    moves::Sequence seq;
+    std::size_t idx = packIndex(pos);
+    std::uint8_t d = compactDistance(idx);
+    if(d == COMPACT_UNREACHED) return seq;
+
+    std::array<int, 4> cur = pos;
+    // every step lowers d, so the walk is at most d moves; a step with no move down means a broken table
+    while(d > 0){
+	std::uint8_t before = d;
+	for(int k = 0; k < cross_table_compact::kMoveCount; k++){
+	    int m = cross_table_compact::kMoves[k];
+	    std::array<int, 4> moved = applyMove(cur, m, next);
+	    if(compactDistance(packIndex(moved)) + 1 == d){
+		// quarter-turn tables solve half turns as two quarters, write them as one like the generator
+		if(seq.length > 0 && seq.moves[seq.length - 1] == m && moves::turn(m) != 2){
+		    seq.moves[seq.length - 1] = static_cast<std::uint8_t>(3 * moves::face(m) + 2);
+		} else {
+		    seq.moves[seq.length++] = static_cast<std::uint8_t>(m);
+		}
+		cur = moved;
+		d--;
+		break;
+	    }
+	}
+	if(d == before) return moves::Sequence{};
+    }
+    return seq;
+}
+
+std::size_t cross::compactTableBytes() noexcept {
+    return sizeof(cross_table_compact::kDist);
+}
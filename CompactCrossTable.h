@@ -0,0 +1,28 @@
+#ifndef COMPACT_CROSS_TABLE_H
+#define COMPACT_CROSS_TABLE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "Moves.h"
+
+/*
+ * Small alternative to the full cross table: only the optimal distance of
+ * every base-24 cross index, 4 bits each (~162 KB instead of several MB of
+ * index, entries and move text). Solutions are rebuilt by walking down the
+ * distance gradient with the coordinate move table, trying moves in the same
+ * order the generator did, so they come out identical to the full table.
+ */
+namespace cross {
+
+    constexpr std::uint8_t COMPACT_UNREACHED = 0xF;
+
+    std::uint8_t compactDistance(std::size_t idx) noexcept;
+
+    // positions as reported by getCrossLocations(), empty sequence when solved, unsolvable or the table has no way down
+    moves::Sequence compactSolution(const std::array<int, 4>& pos) noexcept;
+
+    std::size_t compactTableBytes() noexcept;
+}
+
+#endif
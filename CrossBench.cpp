@@ -0,0 +1,483 @@
+/*
+ * Benchmarks every stage of solving a cross on seeded random scrambles and
+ * prints JSON, so two builds can be compared:
+ *
+ *   cross-bench [--seed N] [--scrambles N] [--length N] [--samples N] [--out FILE]
+ *   cross-bench --check [--seed N] [--length N]
+ *
+ * Each stage runs `samples` timed samples. A sample is a batch of operations
+ * sized so it takes at least ~20 us (cheap stages run thousands per sample),
+ * and the percentiles are over the per-operation time of each sample.
+ * --check compares the EdgeBatch kernels with the scalar code instead.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "CompactCrossTable.h"
+#include "CrossConstants.hpp"
+#include "CrossCache.h"
+#include "CrossCoords.h"
+#include "CrossDistance.h"
+#include "CrossRecordFile.h"
+#include "CrossSweep.h"
+#include "CrossSymmetry.h"
+#include "EdgeBatch.h"
+#include "F2LPairs.h"
+#include "FaceletCube.h"
+#include "Cube.h"
+#include "CubeManipulator.h"
+#include "MoveParser.h"
+#include "Moves.h"
+#include "SolutionPrinter.h"
+#include "SolvingLogic.h"
+
+namespace {
+
+    struct Stat {
+	std::string name;
+	std::string unit;
+	std::size_t ops = 0;
+	std::size_t batch = 0;
+	double nsPerOp = 0.0;
+	double p50 = 0.0;
+	double p90 = 0.0;
+	double p99 = 0.0;
+	double min = 0.0;
+	double max = 0.0;
+    };
+
+    // results are folded in here so the compiler can't drop the work
+    std::size_t sink = 0;
+
+    using Clock = std::chrono::steady_clock;
+
+    template <typename Op>
+    double timeBatch(Op& op, std::size_t batch, std::size_t inputs, std::size_t& cursor){
+	auto start = Clock::now();
+	for(std::size_t k = 0; k < batch; k++){
+	    sink += op(cursor);
+	    if(++cursor == inputs) cursor = 0;
+	}
+	return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    }
+
+    double percentile(const std::vector<double>& sorted, double p){
+	std::size_t i = static_cast<std::size_t>(p * (sorted.size() - 1) + 0.5);
+	return sorted[i];
+    }
+
+    // lanes > 1: every call does that many units of work (batch kernels), times are per unit
+    template <typename Op>
+    Stat measure(const std::string& name, const std::string& unit, std::size_t inputs, unsigned samples, Op op, std::size_t lanes = 1){
+	constexpr double kMinSampleNs = 20000.0;
+	std::size_t cursor = 0;
+
+	// one pass over the inputs to fault in tables and warm caches, then grow
+	// the batch until one sample is long enough for the clock
+	timeBatch(op, inputs, inputs, cursor);
+	std::size_t batch = 1;
+	while(batch < (std::size_t(1) << 24) && timeBatch(op, batch, inputs, cursor) < kMinSampleNs) batch *= 2;
+
+	std::vector<double> perOp;
+	double total = 0.0;
+	for(unsigned s = 0; s < samples; s++){
+	    double ns = timeBatch(op, batch, inputs, cursor);
+	    total += ns;
+	    perOp.push_back(ns / (batch * lanes));
+	}
+	std::sort(perOp.begin(), perOp.end());
+
+	Stat st;
+	st.name = name;
+	st.unit = unit;
+	st.batch = batch;
+	st.ops = batch * samples * lanes;
+	st.nsPerOp = total / st.ops;
+	st.p50 = percentile(perOp, 0.50);
+	st.p90 = percentile(perOp, 0.90);
+	st.p99 = percentile(perOp, 0.99);
+	st.min = perOp.front();
+	st.max = perOp.back();
+	return st;
+    }
+
+    std::vector<std::string> randomScrambles(std::uint64_t seed, std::size_t count, int length){
+	std::mt19937_64 rng(seed);
+	std::vector<std::string> res;
+	for(std::size_t i = 0; i < count; i++) res.push_back(randomScramble(rng, length));
+	return res;
+    }
+
+    void writeJson(std::ostream& out, const std::vector<Stat>& stats, std::uint64_t seed, std::size_t scrambles, int length, unsigned samples){
+	out << "{\n";
+	out << "  \"seed\": " << seed << ",\n";
+	out << "  \"scrambles\": " << scrambles << ",\n";
+	out << "  \"scramble_length\": " << length << ",\n";
+	out << "  \"samples\": " << samples << ",\n";
+	out << "  \"compiler\": \"" << __VERSION__ << "\",\n";
+	out << "  \"benchmarks\": [\n";
+	out.setf(std::ios::fixed);
+	out.precision(2);
+	for(std::size_t i = 0; i < stats.size(); i++){
+	    const Stat& s = stats[i];
+	    out << "    {\"name\": \"" << s.name << "\", \"unit\": \"" << s.unit << "\", \"ops\": " << s.ops << ", \"batch\": " << s.batch
+		<< ", \"ns_per_op\": " << s.nsPerOp << ", \"ops_per_sec\": " << (s.nsPerOp > 0.0 ? 1e9 / s.nsPerOp : 0.0)
+		<< ", \"p50_ns\": " << s.p50 << ", \"p90_ns\": " << s.p90 << ", \"p99_ns\": " << s.p99
+		<< ", \"min_ns\": " << s.min << ", \"max_ns\": " << s.max << "}" << (i + 1 < stats.size() ? "," : "") << "\n";
+	}
+	out << "  ]\n}\n";
+    }
+
+    /*
+     * --check: every lane count from 1 to 1000, random states through the
+     * same moves on each kernel the CPU has, get() and crossIndices() of
+     * every lane against cross::applyMove and crossLocations. Mismatches go
+     * to stderr, false if there were any.
+     */
+    bool checkKernels(std::uint64_t seed, int length){
+	constexpr std::size_t kMaxLanes = 1000;
+	constexpr int kMoves = 8;
+	const cross::EdgeBatch::Kernel kernels[] = {cross::EdgeBatch::Kernel::SCALAR, cross::EdgeBatch::Kernel::SSSE3, cross::EdgeBatch::Kernel::AVX2};
+	const auto& frames = cross::orientationTables();
+	std::mt19937_64 rng(seed);
+	std::size_t lanes = 0;
+	std::size_t failures = 0;
+	std::vector<std::uint32_t> indices(kMaxLanes);
+	for(std::size_t n = 1; n <= kMaxLanes; n++){
+	    std::vector<cross::EdgeLocations> start(n, cross::SOLVED_EDGES);
+	    for(cross::EdgeLocations& loc : start){
+		for(int i = 0; i < length; i++) cross::applyMove(loc, static_cast<int>(rng() % moves::COUNT));
+	    }
+	    // one move on its own, then a sequence, the two paths through the kernels
+	    int single = static_cast<int>(rng() % moves::COUNT);
+	    std::uint8_t seq[kMoves];
+	    for(std::uint8_t& m : seq) m = static_cast<std::uint8_t>(rng() % moves::COUNT);
+	    std::vector<cross::EdgeLocations> want = start;
+	    for(cross::EdgeLocations& loc : want){
+		cross::applyMove(loc, single);
+		cross::applyMoves(loc, seq, kMoves);
+	    }
+	    lanes += n;
+
+	    for(cross::EdgeBatch::Kernel k : kernels){
+		cross::EdgeBatch batch(n);
+		batch.setKernel(k);
+		if(batch.kernel() != k) continue;
+		for(std::size_t i = 0; i < n; i++) batch.set(i, start[i]);
+		batch.applyMove(single);
+		batch.applyMoves(seq, kMoves);
+		for(std::size_t i = 0; i < n; i++){
+		    if(batch.get(i) == want[i]) continue;
+		    if(failures++ < 10) std::cerr << cross::EdgeBatch::kernelName(k) << ": get() of lane " << i << " of " << n << " is wrong" << std::endl;
+		}
+		for(int o = 0; o < 24; o++){
+		    batch.crossIndices(o, indices.data());
+		    for(std::size_t i = 0; i < n; i++){
+			std::uint32_t expect = static_cast<std::uint32_t>(cross::packIndex(cross::crossLocations(want[i], frames[o])));
+			if(indices[i] == expect) continue;
+			if(failures++ < 10){
+			    std::cerr << cross::EdgeBatch::kernelName(k) << ": crossIndices(" << o << ") of lane " << i << " of " << n
+				      << " is " << indices[i] << ", expected " << expect << std::endl;
+			}
+		    }
+		}
+	    }
+	}
+	std::cerr << "kernel check (";
+	for(cross::EdgeBatch::Kernel k : kernels){
+	    cross::EdgeBatch probe(1);
+	    probe.setKernel(k);
+	    if(probe.kernel() == k) std::cerr << (k == cross::EdgeBatch::Kernel::SCALAR ? "" : ", ") << cross::EdgeBatch::kernelName(k);
+	}
+	std::cerr << "): " << lanes << " lanes per kernel, " << failures << " mismatches" << std::endl;
+	return failures == 0;
+    }
+
+    void usage(const char* prog){
+	std::cerr << "usage: " << prog << " [--seed N] [--scrambles N] [--length N] [--samples N] [--out FILE] [--check]" << std::endl;
+    }
+}
+
+int main(int argc, char** argv){
+    std::uint64_t seed = 1;
+    std::size_t count = 2000;
+    int length = 25;
+    unsigned samples = 200;
+    std::string outPath;
+    bool check = false;
+
+    for(int i = 1; i < argc; i++){
+	std::string_view arg = argv[i];
+	if(arg == "--seed" && i + 1 < argc){
+	    seed = std::strtoull(argv[++i], nullptr, 10);
+	} else if(arg == "--scrambles" && i + 1 < argc){
+	    count = std::strtoull(argv[++i], nullptr, 10);
+	} else if(arg == "--length" && i + 1 < argc){
+	    length = std::atoi(argv[++i]);
+	} else if(arg == "--samples" && i + 1 < argc){
+	    samples = static_cast<unsigned>(std::atoi(argv[++i]));
+	} else if(arg == "--out" && i + 1 < argc){
+	    outPath = argv[++i];
+	} else if(arg == "--check"){
+	    check = true;
+	} else {
+	    usage(argv[0]);
+	    return 1;
+	}
+    }
+    if(count == 0 || length <= 0 || samples == 0){
+	usage(argv[0]);
+	return 1;
+    }
+    if(check) return checkKernels(seed, length) ? 0 : 1;
+
+    // inputs for every stage, prepared up front so each stage times only its own work
+    std::vector<std::string> scrambles = randomScrambles(seed, count, length);
+    std::vector<std::vector<std::string>> parsed;
+    std::vector<std::vector<std::uint8_t>> codes;
+    std::vector<Cube> cubes;
+    std::vector<std::array<int, 4>> crossPositions;
+    std::vector<cross::EdgeLocations> edges;
+    std::vector<cross::CornerLocations> corners;
+    std::vector<std::array<moves::Sequence, 24>> crossSeqs;
+    std::vector<std::vector<SolutionRow>> rows;
+    for(const std::string& s : scrambles){
+	parsed.push_back(parseMoveString(s));
+	std::vector<std::uint8_t> buf(MAX_SCRAMBLE_MOVES);
+	buf.resize(parseMoves(s, buf.data(), buf.size()).count);
+	codes.push_back(buf);
+
+	Cube c;
+	CubeManipulator(c).applyMoves(buf.data(), buf.size());
+	cubes.push_back(c);
+	crossPositions.push_back(SolvingLogic(c).getCrossLocations());
+	edges.push_back(cross::edgeLocations(c));
+	corners.push_back(cross::SOLVED_CORNERS);
+	for(std::uint8_t m : buf) cross::applyMove(corners.back(), m);
+
+	SweepResult sols = sweepOrientations(edges.back());
+	std::vector<SolutionRow> r;
+	for(int o = 0; o < 24; o++){
+	    r.push_back({std::string(sols[o]), orientationLabel(o), o, -1, numMoves(sols[o])});
+	}
+	rows.push_back(std::move(r));
+	std::array<moves::Sequence, 24> seqs;
+	for(int o = 0; o < 24; o++){
+	    seqs[o].length = static_cast<std::uint8_t>(parseMoves(sols[o], seqs[o].moves.data(), seqs[o].moves.size()).count);
+	}
+	crossSeqs.push_back(seqs);
+    }
+
+    std::vector<Stat> stats;
+    Cube work;
+    CubeManipulator manip(work);
+    std::ostringstream rendered;
+    std::string record;
+
+    stats.push_back(measure("parseMoveString", "scramble", count, samples, [&](std::size_t i){
+	return parseMoveString(scrambles[i]).size();
+    }));
+    stats.push_back(measure("parseMoves", "scramble", count, samples, [&](std::size_t i){
+	std::uint8_t buf[MAX_SCRAMBLE_MOVES];
+	return parseMoves(scrambles[i], buf, MAX_SCRAMBLE_MOVES).count;
+    }));
+    stats.push_back(measure("CubeManipulator::applyManyMoves", "scramble", count, samples, [&](std::size_t i){
+	manip.applyManyMoves(parsed[i]);
+	return std::size_t(work.getColorAtPosition(Face::DOWN, 0, 1));
+    }));
+    stats.push_back(measure("CubeManipulator::applyMoves", "scramble", count, samples, [&](std::size_t i){
+	manip.applyMoves(codes[i].data(), codes[i].size());
+	return std::size_t(work.getColorAtPosition(Face::DOWN, 0, 1));
+    }));
+    FaceletCube fwork;
+    stats.push_back(measure(std::string("FaceletCube::applyMoves (") + FaceletCube::kernelName() + ")", "scramble", count, samples, [&](std::size_t i){
+	fwork.applyMoves(codes[i].data(), codes[i].size());
+	return std::size_t(fwork.getColorAtPosition(Face::DOWN, 0, 1));
+    }));
+    std::vector<FaceletPerm> composed;
+    for(const std::vector<std::uint8_t>& c : codes) composed.push_back(FaceletCube::sequencePerm(c.data(), c.size()));
+    stats.push_back(measure("FaceletCube::apply (composed scramble)", "scramble", count, samples, [&](std::size_t i){
+	fwork.apply(composed[i]);
+	return std::size_t(fwork.getColorAtPosition(Face::DOWN, 0, 1));
+    }));
+    stats.push_back(measure("FaceletCube::sequencePerm", "scramble", count, samples, [&](std::size_t i){
+	return std::size_t(FaceletCube::sequencePerm(codes[i].data(), codes[i].size()).p[0]);
+    }));
+    std::vector<FaceletCube> fcubes(cubes.begin(), cubes.end());
+    stats.push_back(measure("FaceletCube::orient (incl. copy)", "call", count * 24, samples, [&](std::size_t i){
+	FaceletCube temp = fcubes[i / 24];
+	temp.orient(cross::ORIENTATIONS[i % 24].first, cross::ORIENTATIONS[i % 24].second);
+	return std::size_t(temp.getColorAtPosition(Face::DOWN, 0, 1));
+    }));
+    stats.push_back(measure("Cube::orient (incl. copy)", "call", count * 24, samples, [&](std::size_t i){
+	Cube temp = cubes[i / 24];
+	temp.orient(cross::ORIENTATIONS[i % 24].first, cross::ORIENTATIONS[i % 24].second);
+	return std::size_t(temp.getColorAtPosition(Face::DOWN, 0, 1));
+    }));
+    stats.push_back(measure("SolvingLogic::getCrossLocations", "call", count, samples, [&](std::size_t i){
+	return std::size_t(SolvingLogic(cubes[i]).getCrossLocations()[0]);
+    }));
+    stats.push_back(measure("lookupFLBR_", "lookup", count, samples, [&](std::size_t i){
+	return SolvingLogic::getCrossSolution(crossPositions[i]).size();
+    }));
+    stats.push_back(measure("compactSolution", "lookup", count, samples, [&](std::size_t i){
+	return std::size_t(cross::compactSolution(crossPositions[i]).length);
+    }));
+    stats.push_back(measure("printSolutions", "scramble", count, samples, [&](std::size_t i){
+	rendered.str(std::string());
+	BufferedWriter w(rendered);
+	printSolutions(w, rows[i], cubes[i]);
+	w.flush();
+	return std::size_t(rendered.tellp());
+    }));
+    stats.push_back(measure("printSolutions (no net)", "scramble", count, samples, [&](std::size_t i){
+	rendered.str(std::string());
+	BufferedWriter w(rendered);
+	printSolutions(w, rows[i], cubes[i], nullptr, false);
+	w.flush();
+	return std::size_t(rendered.tellp());
+    }));
+    stats.push_back(measure("appendRows (json)", "scramble", count, samples, [&](std::size_t i){
+	record.clear();
+	appendRows(record, OutputFormat::JSON, scrambles[i], rows[i]);
+	return record.size();
+    }));
+    stats.push_back(measure("appendRows (compact)", "scramble", count, samples, [&](std::size_t i){
+	record.clear();
+	appendRows(record, OutputFormat::COMPACT, scrambles[i], rows[i]);
+	return record.size();
+    }));
+    stats.push_back(measure("sweepOrientations(Cube)", "scramble", count, samples, [&](std::size_t i){
+	return sweepOrientations(cubes[i])[0].size();
+    }));
+    stats.push_back(measure("sweepOrientations(EdgeLocations)", "scramble", count, samples, [&](std::size_t i){
+	return sweepOrientations(edges[i])[0].size();
+    }));
+    stats.push_back(measure("scramble text -> 24 solutions", "scramble", count, samples, [&](std::size_t i){
+	std::uint8_t buf[MAX_SCRAMBLE_MOVES];
+	ParseResult res = parseMoves(scrambles[i], buf, MAX_SCRAMBLE_MOVES);
+	cross::EdgeLocations loc = cross::SOLVED_EDGES;
+	cross::applyMoves(loc, buf, res.count);
+	return sweepOrientations(loc)[0].size();
+    }));
+
+    // the same work on every cube of the corpus at once: scalar per cube vs the SoA kernels
+    std::vector<cross::EdgeLocations> walk = edges;
+    stats.push_back(measure("cross::applyMove", "cube-move", count, samples, [&](std::size_t i){
+	cross::applyMove(walk[i], static_cast<int>(i % moves::COUNT));
+	return std::size_t(walk[i][0]);
+    }));
+    cross::EdgeBatch batch(count);
+    for(std::size_t i = 0; i < count; i++) batch.set(i, edges[i]);
+    std::vector<std::uint32_t> indices(count);
+    const cross::EdgeBatch::Kernel kernels[] = {cross::EdgeBatch::Kernel::SCALAR, cross::EdgeBatch::Kernel::SSSE3, cross::EdgeBatch::Kernel::AVX2};
+    for(cross::EdgeBatch::Kernel k : kernels){
+	batch.setKernel(k);
+	if(batch.kernel() != k) continue;
+	std::string name = std::string("EdgeBatch::applyMove (") + cross::EdgeBatch::kernelName(k) + ")";
+	stats.push_back(measure(name, "cube-move", moves::COUNT, samples, [&](std::size_t m){
+	    batch.applyMove(static_cast<int>(m));
+	    return std::size_t(batch.get(0)[0]);
+	}, count));
+    }
+    const auto& frames = cross::orientationTables();
+    stats.push_back(measure("crossLocations x24", "cube", count, samples, [&](std::size_t i){
+	std::size_t s = 0;
+	for(int o = 0; o < 24; o++){
+	    std::array<int, 4> p = cross::crossLocations(edges[i], frames[o]);
+	    s += p[0] + 24 * (p[1] + 24 * (p[2] + 24 * p[3]));
+	}
+	return s;
+    }));
+    for(cross::EdgeBatch::Kernel k : kernels){
+	batch.setKernel(k);
+	if(batch.kernel() != k) continue;
+	std::string name = std::string("EdgeBatch::crossIndices x24 (") + cross::EdgeBatch::kernelName(k) + ")";
+	stats.push_back(measure(name, "cube", 1, samples, [&](std::size_t){
+	    for(int o = 0; o < 24; o++) batch.crossIndices(o, indices.data());
+	    return std::size_t(indices[0]);
+	}, count));
+    }
+    batch.setKernel(cross::EdgeBatch::bestKernel());
+    std::vector<std::string_view> views(count);
+    stats.push_back(measure("EdgeBatch::solutions x24", "cube", 1, samples, [&](std::size_t){
+	for(int o = 0; o < 24; o++) batch.solutions(o, views.data());
+	return views[0].size();
+    }, count));
+
+    // F2L pairs left by each orientation's cross, the per-candidate cost of --f2l ranking
+    stats.push_back(measure("cross::pairsAfter", "candidate", count * 24, samples, [&](std::size_t i){
+	std::size_t k = i / 24;
+	int o = static_cast<int>(i % 24);
+	return std::size_t(cross::f2lScore(cross::pairsAfter(edges[k], corners[k], o, crossSeqs[k][o])));
+    }));
+
+    // result cache: hashing, then lookups that hit (roomy cache, warmed) / all miss (capacity 1, every insert evicts)
+    stats.push_back(measure("edgeHash", "cube", count, samples, [&](std::size_t i){
+	return std::size_t(cross::edgeHash(edges[i]));
+    }));
+    for(bool symmetric : {false, true}){
+	std::string kind = symmetric ? " (symmetric)" : "";
+	cross::CrossCache warm(16 * count, symmetric);
+	std::vector<cross::HashedEdges> states;
+	for(const cross::EdgeLocations& loc : edges){
+	    states.emplace_back(loc);
+	    warm.solve(states.back());
+	}
+	stats.push_back(measure("CrossCache::solve hit" + kind, "scramble", count, samples, [&](std::size_t i){
+	    return warm.solve(states[i])[0].size();
+	}));
+	cross::CrossCache cold(1, symmetric);
+	stats.push_back(measure("CrossCache::solve miss" + kind, "scramble", count, samples, [&](std::size_t i){
+	    return cold.solve(states[i])[0].size();
+	}));
+    }
+
+    // binary records: building one, reading them back from a stream, and scanning them in memory the way a mapped file is
+    std::vector<cross::CrossRecord> records(count);
+    stats.push_back(measure("cross::makeRecord", "scramble", count, samples, [&](std::size_t i){
+	records[i] = cross::makeRecord(edges[i], corners[i]);
+	return std::size_t(records[i].best);
+    }));
+    std::ostringstream recordBytes;
+    {
+	cross::RecordWriter writer(recordBytes);
+	for(const cross::CrossRecord& r : records) writer.write(r);
+    }
+    std::string recordFile = recordBytes.str();
+    stats.push_back(measure("RecordReader::next (whole file)", "record", 1, samples, [&](std::size_t){
+	std::istringstream in(recordFile);
+	cross::RecordReader reader(in);
+	cross::CrossRecord r;
+	std::size_t sum = 0;
+	while(reader.next(r)) sum += r.best;
+	return sum;
+    }, count));
+    stats.push_back(measure("CrossRecord scan (best)", "record", 1, samples, [&](std::size_t){
+	std::size_t sum = 0;
+	for(const cross::CrossRecord& r : records) sum += r.best;
+	return sum;
+    }, count));
+
+    if(outPath.empty()){
+	writeJson(std::cout, stats, seed, count, length, samples);
+    } else {
+	std::ofstream out(outPath);
+	if(!out){
+	    std::cerr << "cannot open " << outPath << std::endl;
+	    return 1;
+	}
+	writeJson(out, stats, seed, count, length, samples);
+    }
+    std::cerr << "bench: " << stats.size() << " stages (checksum " << sink << ")" << std::endl;
+    return 0;
+}
@@ -0,0 +1,205 @@
+#include "CrossCache.h"
+
+namespace {
+
+    std::uint64_t splitmix(std::uint64_t& s){
+	std::uint64_t z = (s += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+    }
+
+    // zobrist[p][l]: piece p's reference sticker at location l
+    using ZobristTable = std::array<std::array<std::uint64_t, 24>, 12>;
+
+    const ZobristTable& zobrist(){
+	static const ZobristTable table = []{
+	    ZobristTable t;
+	    std::uint64_t seed = 0x43524F5353ULL;
+	    for(auto& piece : t){
+		for(auto& key : piece) key = splitmix(seed);
+	    }
+	    return t;
+	}();
+	return table;
+    }
+
+    std::uint64_t pack(const cross::EdgeLocations& loc){
+	std::uint64_t key = 1ULL << 63;
+	for(int p = 0; p < 12; p++) key |= static_cast<std::uint64_t>(loc[p]) << (5 * p);
+	return key;
+    }
+
+    /*
+     * order[g][o]: the orientation of the original state that orientation o of
+     * orientEdges(state, frame g) answers. Found by matching the four cross
+     * locations on a handful of scrambled states, which pins every pair down.
+     */
+    using FrameOrders = std::array<std::array<std::uint8_t, 24>, 24>;
+
+    const FrameOrders& frameOrders(){
+	static const FrameOrders orders = []{
+	    const auto& tables = cross::orientationTables();
+	    std::array<cross::EdgeLocations, 6> samples;
+	    std::uint64_t seed = 1;
+	    for(auto& s : samples){
+		s = cross::SOLVED_EDGES;
+		for(int i = 0; i < 30; i++) cross::applyMove(s, static_cast<int>(splitmix(seed) % moves::COUNT));
+	    }
+	    FrameOrders res;
+	    for(int g = 0; g < 24; g++){
+		for(int o = 0; o < 24; o++){
+		    res[g][o] = 0;
+		    for(int q = 0; q < 24; q++){
+			bool same = true;
+			for(const auto& s : samples){
+			    if(cross::crossLocations(cross::orientEdges(s, tables[g]), tables[o]) != cross::crossLocations(s, tables[q])){
+				same = false;
+				break;
+			    }
+			}
+			if(same){
+			    res[g][o] = static_cast<std::uint8_t>(q);
+			    break;
+			}
+		    }
+		}
+	    }
+	    return res;
+	}();
+	return orders;
+    }
+}
+
+namespace cross {
+
+    std::uint64_t edgeHash(const EdgeLocations& loc){
+	const ZobristTable& z = zobrist();
+	std::uint64_t h = 0;
+	for(int p = 0; p < 12; p++) h ^= z[p][loc[p]];
+	return h;
+    }
+
+    HashedEdges::HashedEdges() : hash(edgeHash(SOLVED_EDGES)) {}
+
+    HashedEdges::HashedEdges(const EdgeLocations& l) : loc(l), hash(edgeHash(l)) {}
+
+    CrossCache::CrossCache(std::size_t capacity, bool symmetric) : symmetric_(symmetric), setsPerShard_(1) {
+	std::size_t perShard = (capacity + (std::size_t(kWays) << kShardBits) - 1) / (std::size_t(kWays) << kShardBits);
+	while(setsPerShard_ < perShard) setsPerShard_ <<= 1;
+	shards_.reserve(std::size_t(1) << kShardBits);
+	for(int s = 0; s < (1 << kShardBits); s++){
+	    auto shard = std::make_unique<Shard>();
+	    shard->keys.assign(kWays * setsPerShard_, 0);
+	    shard->used.assign(kWays * setsPerShard_, 0);
+	    shard->sols.resize(kWays * setsPerShard_);
+	    shards_.push_back(std::move(shard));
+	}
+	orientationTables();
+	if(symmetric_) frameOrders();
+    }
+
+    CrossCache::Canonical CrossCache::canonical_(const HashedEdges& state) const {
+	if(!symmetric_) return {pack(state.loc), state.hash, nullptr};
+	// least orientEdges() result, compared a piece at a time over the frames still tied
+	const auto& tables = orientationTables();
+	std::uint8_t frames[24];
+	std::uint8_t value[24];
+	int tied = 24;
+	for(int g = 0; g < 24; g++) frames[g] = static_cast<std::uint8_t>(g);
+	for(int p = 0; p < 12 && tied > 1; p++){
+	    std::uint8_t least = 0xFF;
+	    for(int k = 0; k < tied; k++){
+		const OrientationTable& t = tables[frames[k]];
+		int s = t.physical[2 * p];
+		value[k] = t.relabel[state.loc[s >> 1] ^ (s & 1)];
+		if(value[k] < least) least = value[k];
+	    }
+	    int kept = 0;
+	    for(int k = 0; k < tied; k++){
+		if(value[k] == least) frames[kept++] = frames[k];
+	    }
+	    tied = kept;
+	}
+	EdgeLocations best = orientEdges(state.loc, tables[frames[0]]);
+	return {pack(best), edgeHash(best), &frameOrders()[frames[0]]};
+    }
+
+    bool CrossCache::lookup(const HashedEdges& state, SweepResult& out){
+	return lookup_(canonical_(state), out);
+    }
+
+    void CrossCache::insert(const HashedEdges& state, const SweepResult& res){
+	insert_(canonical_(state), res);
+    }
+
+    bool CrossCache::lookup_(const Canonical& c, SweepResult& out){
+	Shard& shard = shard_(c.hash);
+	std::size_t first = kWays * (c.hash & (setsPerShard_ - 1));
+	std::lock_guard<std::mutex> lock(shard.mtx);
+	for(std::size_t i = first; i < first + kWays; i++){
+	    if(shard.keys[i] != c.key) continue;
+	    const SweepResult& stored = shard.sols[i];
+	    if(c.order){
+		for(int o = 0; o < 24; o++) out[(*c.order)[o]] = stored[o];
+	    } else {
+		out = stored;
+	    }
+	    shard.used[i] = ++shard.tick;
+	    shard.hits++;
+	    return true;
+	}
+	shard.misses++;
+	return false;
+    }
+
+    void CrossCache::insert_(const Canonical& c, const SweepResult& res){
+	Shard& shard = shard_(c.hash);
+	std::size_t first = kWays * (c.hash & (setsPerShard_ - 1));
+	std::lock_guard<std::mutex> lock(shard.mtx);
+	// the same state (another thread got there first), else an empty way, else the stalest
+	std::size_t slot = first;
+	for(std::size_t i = first; i < first + kWays; i++){
+	    if(shard.keys[i] == c.key){
+		slot = i;
+		break;
+	    }
+	    if(shard.keys[slot] != 0 && (shard.keys[i] == 0 || shard.used[i] - shard.used[slot] > 0x80000000u)) slot = i;
+	}
+	if(shard.keys[slot] == 0){
+	    shard.entries++;
+	} else if(shard.keys[slot] != c.key){
+	    shard.evictions++;
+	}
+	shard.keys[slot] = c.key;
+	shard.used[slot] = ++shard.tick;
+	SweepResult& stored = shard.sols[slot];
+	if(c.order){
+	    for(int o = 0; o < 24; o++) stored[o] = res[(*c.order)[o]];
+	} else {
+	    stored = res;
+	}
+    }
+
+    SweepResult CrossCache::solve(const HashedEdges& state){
+	Canonical c = canonical_(state);
+	SweepResult res;
+	if(lookup_(c, res)) return res;
+	res = sweepOrientations(state.loc);
+	insert_(c, res);
+	return res;
+    }
+
+    CrossCache::Stats CrossCache::stats() const {
+	Stats s;
+	for(const auto& shard : shards_){
+	    std::lock_guard<std::mutex> lock(shard->mtx);
+	    s.hits += shard->hits;
+	    s.misses += shard->misses;
+	    s.evictions += shard->evictions;
+	    s.entries += shard->entries;
+	}
+	s.capacity = shards_.size() * kWays * setsPerShard_;
+	return s;
+    }
+}
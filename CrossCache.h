@@ -0,0 +1,102 @@
+#ifndef CROSS_CACHE_H
+#define CROSS_CACHE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "CrossCoords.h"
+#include "CrossSweep.h"
+
+namespace cross {
+
+    // Zobrist hash of an edge state: one random key per (piece, location), XORed
+    std::uint64_t edgeHash(const EdgeLocations& loc);
+
+    // edge state with its hash, worked out once for the final state (cheaper than updating it on every move)
+    struct HashedEdges {
+	EdgeLocations loc = SOLVED_EDGES;
+	std::uint64_t hash;
+
+	//Constructor
+	HashedEdges();
+	explicit HashedEdges(const EdgeLocations& l);
+    };
+
+    /*
+     * Bounded, thread-safe memo of the 24-orientation sweep. The key is the
+     * whole 12-edge state packed into 60 bits, so a hit is never a different
+     * state; the hash only picks the slot. Slots are 4-way sets split across
+     * independently locked shards, and a full set drops its least recently
+     * used entry.
+     *
+     * With symmetric keys a state is first replaced by the least of its 24
+     * whole-cube conjugates (the same scramble done from another side). Those
+     * share one sweep up to a reordering of the orientations, so a scramble
+     * and its mirror images across the 24 frames take a single entry.
+     */
+    class CrossCache {
+    public:
+	struct Stats {
+	    std::uint64_t hits = 0;
+	    std::uint64_t misses = 0;
+	    std::uint64_t evictions = 0;
+	    std::size_t entries = 0;
+	    std::size_t capacity = 0;
+	};
+
+	//Constructor: room for about `capacity` states
+	explicit CrossCache(std::size_t capacity, bool symmetric = false);
+
+	// answered from memory, or swept and remembered
+	SweepResult solve(const HashedEdges& state);
+	SweepResult solve(const EdgeLocations& loc) { return solve(HashedEdges(loc)); }
+
+	// the two halves of solve(), for callers that sweep misses in bulk
+	bool lookup(const HashedEdges& state, SweepResult& out);
+	void insert(const HashedEdges& state, const SweepResult& res);
+
+	Stats stats() const;
+	bool symmetric() const { return symmetric_; }
+
+    private:
+	static constexpr int kShardBits = 6;
+	static constexpr int kWays = 4;
+
+	/*
+	 * Set s is ways [kWays * s, kWays * s + kWays). Keys sit apart from the
+	 * results so a lookup scans one cache line before touching a result.
+	 */
+	struct Shard {
+	    mutable std::mutex mtx;
+	    std::vector<std::uint64_t> keys;	//packed state with bit 63 set, 0 when empty
+	    std::vector<std::uint32_t> used;	//tick of the last hit or insert, least is evicted
+	    std::vector<SweepResult> sols;
+	    std::uint32_t tick = 0;
+	    std::uint64_t hits = 0;
+	    std::uint64_t misses = 0;
+	    std::uint64_t evictions = 0;
+	    std::size_t entries = 0;
+	};
+
+	// state as stored: its key, hash and how stored orientations map back
+	struct Canonical {
+	    std::uint64_t key;
+	    std::uint64_t hash;
+	    const std::array<std::uint8_t, 24>* order;	//stored[o] answers orientation order[o], null for identity
+	};
+
+	Canonical canonical_(const HashedEdges& state) const;
+	bool lookup_(const Canonical& c, SweepResult& out);
+	void insert_(const Canonical& c, const SweepResult& res);
+	Shard& shard_(std::uint64_t hash) { return *shards_[hash >> (64 - kShardBits)]; }
+
+	bool symmetric_;
+	std::size_t setsPerShard_;
+	std::vector<std::unique_ptr<Shard>> shards_;
+    };
+}
+
+#endif
@@ -0,0 +1,221 @@
+/*
+ * Client for cross-solver --serve.
+ *
+ *   cross-client SOCKET                 send each stdin line, print each reply
+ *   cross-client SOCKET --load N [--connections C] [--seed S] [--length L] [--options OPTS]
+ *
+ * --load sends N seeded random scrambles over C connections, each keeping one
+ * request in flight, and prints the request latency percentiles as JSON.
+ */
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "MoveParser.h"
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    class Connection {
+    private:
+	int fd_ = -1;
+	std::string buffered_;	//bytes after the last reply handed out
+
+    public:
+	//Constructor
+	Connection() = default;
+	Connection(const Connection&) = delete;
+	Connection& operator=(const Connection&) = delete;
+	~Connection(){ if(fd_ >= 0) ::close(fd_); }
+
+	bool open(const std::string& path){
+	    sockaddr_un addr{};
+	    addr.sun_family = AF_UNIX;
+	    if(path.size() >= sizeof(addr.sun_path)){
+		std::cerr << "socket path too long: " << path << std::endl;
+		return false;
+	    }
+	    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+	    fd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	    if(fd_ < 0 || ::connect(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0){
+		std::cerr << "cannot connect to " << path << ": " << std::strerror(errno) << std::endl;
+		return false;
+	    }
+	    return true;
+	}
+
+	// one request line, newline added
+	bool send(std::string line){
+	    line += '\n';
+	    std::size_t sent = 0;
+	    while(sent < line.size()){
+		ssize_t n = ::send(fd_, line.data() + sent, line.size() - sent, MSG_NOSIGNAL);
+		if(n < 0 && errno == EINTR) continue;
+		if(n <= 0) return false;
+		sent += static_cast<std::size_t>(n);
+	    }
+	    return true;
+	}
+
+	// next reply line without its newline, false once the server hangs up
+	bool receive(std::string& reply){
+	    for(;;){
+		std::size_t nl = buffered_.find('\n');
+		if(nl != std::string::npos){
+		    reply.assign(buffered_, 0, nl);
+		    buffered_.erase(0, nl + 1);
+		    return true;
+		}
+		char buf[16384];
+		ssize_t n = ::recv(fd_, buf, sizeof(buf), 0);
+		if(n < 0 && errno == EINTR) continue;
+		if(n <= 0) return false;
+		buffered_.append(buf, static_cast<std::size_t>(n));
+	    }
+	}
+    };
+
+    int runPipe(const std::string& path){
+	Connection conn;
+	if(!conn.open(path)) return 1;
+	std::string line;
+	std::string reply;
+	while(std::getline(std::cin, line)){
+	    if(!conn.send(line) || !conn.receive(reply)){
+		std::cerr << "server closed the connection" << std::endl;
+		return 1;
+	    }
+	    std::cout << reply << '\n';
+	}
+	std::cout.flush();
+	return 0;
+    }
+
+    struct LoadResult {
+	std::vector<double> latencyUs;
+	std::size_t errors = 0;	//replies with "ok":false
+	bool failed = false;	//lost the connection
+    };
+
+    void loadWorker(const std::string& path, std::vector<std::string> requests, LoadResult& res){
+	Connection conn;
+	if(!conn.open(path)){
+	    res.failed = true;
+	    return;
+	}
+	res.latencyUs.reserve(requests.size());
+	std::string reply;
+	for(std::string& req : requests){
+	    auto start = Clock::now();
+	    if(!conn.send(std::move(req)) || !conn.receive(reply)){
+		res.failed = true;
+		return;
+	    }
+	    res.latencyUs.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+	    if(reply.compare(0, 10, "{\"ok\":true") != 0) res.errors++;
+	}
+    }
+
+    double percentile(const std::vector<double>& sorted, double p){
+	if(sorted.empty()) return 0.0;
+	std::size_t i = static_cast<std::size_t>(p * (sorted.size() - 1) + 0.5);
+	return sorted[i];
+    }
+
+    int runLoad(const std::string& path, std::size_t total, unsigned connections, std::uint64_t seed, int length, const std::string& options){
+	// every request is built before the clock starts
+	std::mt19937_64 rng(seed);
+	std::vector<std::vector<std::string>> perConn(connections);
+	for(std::size_t i = 0; i < total; i++){
+	    std::string req = options.empty() ? std::string() : options + "|";
+	    req += randomScramble(rng, length);
+	    perConn[i % connections].push_back(std::move(req));
+	}
+
+	std::vector<LoadResult> results(connections);
+	std::vector<std::thread> threads;
+	auto start = Clock::now();
+	for(unsigned c = 0; c < connections; c++){
+	    threads.emplace_back(loadWorker, std::cref(path), std::move(perConn[c]), std::ref(results[c]));
+	}
+	for(std::thread& t : threads) t.join();
+	double secs = std::chrono::duration<double>(Clock::now() - start).count();
+
+	std::vector<double> all;
+	std::size_t errors = 0;
+	bool failed = false;
+	for(const LoadResult& r : results){
+	    all.insert(all.end(), r.latencyUs.begin(), r.latencyUs.end());
+	    errors += r.errors;
+	    failed = failed || r.failed;
+	}
+	std::sort(all.begin(), all.end());
+
+	std::cout.setf(std::ios::fixed);
+	std::cout.precision(1);
+	std::cout << "{\"requests\": " << all.size() << ", \"connections\": " << connections << ", \"seed\": " << seed
+		  << ", \"scramble_length\": " << length << ", \"errors\": " << errors << ", \"seconds\": " << std::setprecision(3) << secs << std::setprecision(1)
+		  << ", \"requests_per_sec\": " << (secs > 0.0 ? all.size() / secs : 0.0)
+		  << ", \"p50_us\": " << percentile(all, 0.50) << ", \"p90_us\": " << percentile(all, 0.90)
+		  << ", \"p99_us\": " << percentile(all, 0.99) << ", \"max_us\": " << (all.empty() ? 0.0 : all.back()) << "}" << std::endl;
+	if(failed) std::cerr << "load: lost a connection, " << (total - all.size()) << " requests unanswered" << std::endl;
+	return failed ? 1 : 0;
+    }
+
+    void usage(const char* prog){
+	std::cerr << "usage: " << prog << " SOCKET                 send stdin lines, print replies" << std::endl;
+	std::cerr << "       " << prog << " SOCKET --load N [--connections C] [--seed S] [--length L] [--options OPTS]" << std::endl;
+    }
+}
+
+int main(int argc, char** argv){
+    if(argc < 2 || argv[1][0] == '-'){
+	usage(argv[0]);
+	return 1;
+    }
+    std::string path = argv[1];
+    std::size_t load = 0;
+    unsigned connections = 1;
+    std::uint64_t seed = 1;
+    int length = 25;
+    std::string options;
+
+    for(int i = 2; i < argc; i++){
+	std::string_view arg = argv[i];
+	if(arg == "--load" && i + 1 < argc){
+	    load = std::strtoull(argv[++i], nullptr, 10);
+	} else if(arg == "--connections" && i + 1 < argc){
+	    connections = static_cast<unsigned>(std::atoi(argv[++i]));
+	} else if(arg == "--seed" && i + 1 < argc){
+	    seed = std::strtoull(argv[++i], nullptr, 10);
+	} else if(arg == "--length" && i + 1 < argc){
+	    length = std::atoi(argv[++i]);
+	} else if(arg == "--options" && i + 1 < argc){
+	    options = argv[++i];
+	} else {
+	    usage(argv[0]);
+	    return 1;
+	}
+    }
+    if(connections == 0 || length <= 0){
+	usage(argv[0]);
+	return 1;
+    }
+
+    if(load > 0) return runLoad(path, load, connections, seed, length, options);
+    return runPipe(path);
+}
@@ -1,6 +1,7 @@
 #pragma once
 #include <array>
 #include <tuple>
+#include <utility>
 #include "Cube.h"  // for Face enum
 
 namespace cross {
@@ -39,4 +40,67 @@ namespace cross {
 	{Face::RIGHT, 2, 1},  // 23 = DR: RIGHT sticker	 
     }};
 
+    /*
+     * Corner stickers, three per corner slot. Slots are URF, UFL, ULB, UBR,
+     * DFR, DLF, DBL, DRB and each slot lists its U/D sticker first, then the
+     * other two going clockwise around the corner.
+     */
+    constexpr std::array<std::tuple<Face, int, int>, 24> CORNER_POSITIONS{{
+	{Face::UP,    2, 2},  // 0 = URF: UP sticker
+	{Face::RIGHT, 0, 0},  // 1 = URF: RIGHT sticker
+	{Face::FRONT, 0, 2},  // 2 = URF: FRONT sticker
+	{Face::UP,    2, 0},  // 3 = UFL: UP sticker
+	{Face::FRONT, 0, 0},  // 4 = UFL: FRONT sticker
+	{Face::LEFT,  0, 2},  // 5 = UFL: LEFT sticker
+	{Face::UP,    0, 0},  // 6 = ULB: UP sticker
+	{Face::LEFT,  0, 0},  // 7 = ULB: LEFT sticker
+	{Face::BACK,  0, 2},  // 8 = ULB: BACK sticker
+	{Face::UP,    0, 2},  // 9 = UBR: UP sticker
+	{Face::BACK,  0, 0},  // 10 = UBR: BACK sticker
+	{Face::RIGHT, 0, 2},  // 11 = UBR: RIGHT sticker
+	{Face::DOWN,  0, 2},  // 12 = DFR: DOWN sticker
+	{Face::FRONT, 2, 2},  // 13 = DFR: FRONT sticker
+	{Face::RIGHT, 2, 0},  // 14 = DFR: RIGHT sticker
+	{Face::DOWN,  0, 0},  // 15 = DLF: DOWN sticker
+	{Face::LEFT,  2, 2},  // 16 = DLF: LEFT sticker
+	{Face::FRONT, 2, 0},  // 17 = DLF: FRONT sticker
+	{Face::DOWN,  2, 0},  // 18 = DBL: DOWN sticker
+	{Face::BACK,  2, 2},  // 19 = DBL: BACK sticker
+	{Face::LEFT,  2, 0},  // 20 = DBL: LEFT sticker
+	{Face::DOWN,  2, 2},  // 21 = DRB: DOWN sticker
+	{Face::RIGHT, 2, 2},  // 22 = DRB: RIGHT sticker
+	{Face::BACK,  2, 0},  // 23 = DRB: BACK sticker
+    }};
+
+    /*
+     * Every (Down, Front) pair the solver sweeps over, in output order.
+     * Six cross colors x four possible front faces.
+     */
+    constexpr std::array<std::pair<Face, Face>, 24> ORIENTATIONS{{
+	{Face::UP, Face::RIGHT},
+	{Face::UP, Face::BACK},
+	{Face::UP, Face::LEFT},
+	{Face::UP, Face::FRONT},
+	{Face::DOWN, Face::RIGHT},
+	{Face::DOWN, Face::BACK},
+	{Face::DOWN, Face::LEFT},
+	{Face::DOWN, Face::FRONT},
+	{Face::RIGHT, Face::UP},
+	{Face::RIGHT, Face::BACK},
+	{Face::RIGHT, Face::DOWN},
+	{Face::RIGHT, Face::FRONT},
+	{Face::LEFT, Face::UP},
+	{Face::LEFT, Face::BACK},
+	{Face::LEFT, Face::DOWN},
+	{Face::LEFT, Face::FRONT},
+	{Face::BACK, Face::UP},
+	{Face::BACK, Face::LEFT},
+	{Face::BACK, Face::DOWN},
+	{Face::BACK, Face::RIGHT},
+	{Face::FRONT, Face::UP},
+	{Face::FRONT, Face::LEFT},
+	{Face::FRONT, Face::DOWN},
+	{Face::FRONT, Face::RIGHT}
+    }};
+
 }
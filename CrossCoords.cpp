@@ -0,0 +1,46 @@
+#include "CrossCoords.h"
+#include "CubieCube.h"
+
+namespace {
+
+    /*
+     * Taken from the CubieCube move tables: slot s of the moved cube holds
+     * whatever was in slot ep[s], flipped by eo[s].
+     */
+    cross::MoveTable buildEdgeMoves(){
+	cross::MoveTable next{};
+	for(int m = 0; m < moves::COUNT; m++){
+	    const CubieCube& mv = CubieCube::move(m);
+	    for(int s = 0; s < 12; s++){
+		for(int flip = 0; flip < 2; flip++){
+		    next[2 * mv.ep[s] + flip][m] = static_cast<std::uint8_t>(2 * s + (flip ^ mv.eo[s]));
+		}
+	    }
+	}
+	return next;
+    }
+
+    // corners the same way, twisted by co[s] (mod 3)
+    cross::MoveTable buildCornerMoves(){
+	cross::MoveTable next{};
+	for(int m = 0; m < moves::COUNT; m++){
+	    const CubieCube& mv = CubieCube::move(m);
+	    for(int s = 0; s < 8; s++){
+		for(int t = 0; t < 3; t++){
+		    next[3 * mv.cp[s] + t][m] = static_cast<std::uint8_t>(3 * s + (t + mv.co[s]) % 3);
+		}
+	    }
+	}
+	return next;
+    }
+}
+
+const cross::MoveTable& cross::edgeMoveTable(){
+    static const MoveTable table = buildEdgeMoves();
+    return table;
+}
+
+const cross::MoveTable& cross::cornerMoveTable(){
+    static const MoveTable table = buildCornerMoves();
+    return table;
+}
@@ -0,0 +1,46 @@
+#ifndef CROSS_COORDS_H
+#define CROSS_COORDS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "CrossSymmetry.h"
+#include "Moves.h"
+
+namespace cross {
+
+    // next[l][m] = where a sticker at EDGE_POSITIONS index l ends up after move m
+    using MoveTable = std::array<std::array<std::uint8_t, moves::COUNT>, 24>;
+
+    const MoveTable& edgeMoveTable();
+    // same for CORNER_POSITIONS indices
+    const MoveTable& cornerMoveTable();
+
+    // solved edge state, every piece home with its reference sticker on the even index
+    constexpr EdgeLocations SOLVED_EDGES{{0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22}};
+    constexpr CornerLocations SOLVED_CORNERS{{0, 3, 6, 9, 12, 15, 18, 21}};
+
+    /*
+     * Scrambles straight in coordinate space: 12 table reads per move covers
+     * the cross edges of all six colours, no Cube or CubieCube involved.
+     */
+    inline void applyMove(EdgeLocations& loc, int move, const MoveTable& next = edgeMoveTable()) {
+	for(std::uint8_t& l : loc) l = next[l][move];
+    }
+
+    inline void applyMove(CornerLocations& loc, int move, const MoveTable& next = cornerMoveTable()) {
+	for(std::uint8_t& l : loc) l = next[l][move];
+    }
+
+    inline void applyMoves(EdgeLocations& loc, const std::uint8_t* moves, std::size_t n) {
+	const MoveTable& next = edgeMoveTable();
+	for(std::size_t i = 0; i < n; i++) applyMove(loc, moves[i], next);
+    }
+
+    // same move applied to the four positions getCrossLocations() reports
+    inline std::array<int, 4> applyMove(const std::array<int, 4>& pos, int move, const MoveTable& next = edgeMoveTable()) {
+	return {next[pos[0]][move], next[pos[1]][move], next[pos[2]][move], next[pos[3]][move]};
+    }
+}
+
+#endif
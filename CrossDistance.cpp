@@ -0,0 +1,43 @@
+#include "CrossDistance.h"
+#include "CrossCoords.h"
+#include "DistanceTable.h"
+
+std::vector<int> cross::allMoves(){
+    std::vector<int> res;
+    for(int m = 0; m < moves::COUNT; m++) res.push_back(m);
+    return res;
+}
+
+const std::vector<std::uint8_t>& cross::distanceTable(){
+    static const std::vector<std::uint8_t> table = buildDistances(allMoves(), 1);
+    return table;
+}
+
+std::vector<std::uint8_t> cross::buildDistances(const std::vector<int>& moveSet, unsigned threads){
+    const MoveTable& next = edgeMoveTable();
+    auto step = [&](std::size_t idx, int k){
+	return packIndex(applyMove(unpackIndex(idx), moveSet[k], next));
+    };
+    return dist::bfs(STATES, {SOLVED_INDEX}, static_cast<int>(moveSet.size()), step, threads);
+}
+
+std::vector<int> cross::descend(const std::vector<std::uint8_t>& dist, std::size_t idx, const std::vector<int>& moveSet){
+    const MoveTable& next = edgeMoveTable();
+    std::vector<int> sol;
+    if(dist[idx] == dist::UNREACHED) return sol;
+
+    std::array<int, 4> pos = unpackIndex(idx);
+    while(dist[idx] > 0){
+	for(int m : moveSet){
+	    std::array<int, 4> moved = applyMove(pos, m, next);
+	    std::size_t t = packIndex(moved);
+	    if(dist[t] + 1 == dist[idx]){
+		sol.push_back(m);
+		pos = moved;
+		idx = t;
+		break;
+	    }
+	}
+    }
+    return sol;
+}
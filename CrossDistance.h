@@ -0,0 +1,58 @@
+#ifndef CROSS_DISTANCE_H
+#define CROSS_DISTANCE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cross {
+
+    /*
+     * Same packing as SolvingLogic::crossIndex_: positions of the F, R, B, L
+     * cross edges (as reported by getCrossLocations) in base 24.
+     */
+    constexpr std::size_t BASE = 24;
+    constexpr std::size_t STATES = BASE * BASE * BASE * BASE;
+
+    constexpr std::size_t packIndex(int f, int l, int b, int r) {
+	return static_cast<std::size_t>(f) + BASE * (static_cast<std::size_t>(l) + BASE * (static_cast<std::size_t>(b) + BASE * static_cast<std::size_t>(r)));
+    }
+
+    inline std::size_t packIndex(const std::array<int, 4>& pos) {
+	return packIndex(pos[0], pos[1], pos[2], pos[3]);
+    }
+
+    inline std::array<int, 4> unpackIndex(std::size_t idx) {
+	std::array<int, 4> pos;
+	for(int k = 0; k < 4; k++){
+	    pos[k] = static_cast<int>(idx % BASE);
+	    idx /= BASE;
+	}
+	return pos;
+    }
+
+    // DF, DR, DB, DL down stickers
+    constexpr std::size_t SOLVED_INDEX = packIndex(16, 22, 20, 18);
+
+    /*
+     * Optimal distance to the solved cross for every index slot using only
+     * the given move codes (closed under inverses). Slots that aren't a real
+     * cross state hold dist::UNREACHED.
+     */
+    std::vector<std::uint8_t> buildDistances(const std::vector<int>& moveSet, unsigned threads);
+
+    /*
+     * Optimal solution by walking down the distance gradient, always taking
+     * the first move in moveSet order that gets one step closer.
+     */
+    std::vector<int> descend(const std::vector<std::uint8_t>& dist, std::size_t idx, const std::vector<int>& moveSet);
+
+    std::vector<int> allMoves();
+
+    // HTM distances over all 18 moves, built on first use and shared
+    const std::vector<std::uint8_t>& distanceTable();
+}
+
+#endif
@@ -0,0 +1,64 @@
+#include "CrossEnumerator.h"
+#include "CrossCoords.h"
+#include "CrossDistance.h"
+#include "DistanceTable.h"
+#include "IdaSearch.h"
+
+namespace {
+
+    struct Search {
+	const std::vector<std::uint8_t>& dist;
+	const cross::MoveTable& next;
+	std::size_t limit;
+	std::vector<moves::Sequence>& out;
+	moves::Sequence path;
+
+	// exactly `left` more moves to the solved cross
+	void run(const std::array<int, 4>& pos, std::size_t idx, int left, int prev){
+	    if(out.size() >= limit) return;
+	    if(left == 0){
+		out.push_back(path);
+		return;
+	    }
+	    for(int m = 0; m < moves::COUNT; m++){
+		if(!ida::canFollow(prev, m)) continue;
+		std::array<int, 4> moved = cross::applyMove(pos, m, next);
+		std::size_t t = cross::packIndex(moved);
+		if(t == idx) continue;
+		int d = dist[t];
+		if(d > left - 1) continue;
+		if(d == 0 && left > 1) continue;
+		path.moves[path.length++] = static_cast<std::uint8_t>(m);
+		run(moved, t, left - 1, m);
+		--path.length;
+	    }
+	}
+    };
+}
+
+CrossEnumerator::CrossEnumerator() : dist_(cross::distanceTable()) {}
+
+std::vector<moves::Sequence> CrossEnumerator::enumerate(std::size_t crossIdx, int slack, std::size_t limit) const {
+    std::vector<moves::Sequence> res;
+    int best = dist_[crossIdx];
+    if(best == dist::UNREACHED) return res;
+    if(best == 0){
+	res.push_back(moves::Sequence{});
+	return res;
+    }
+
+    Search search{dist_, cross::edgeMoveTable(), limit, res, {}};
+    for(int len = best; len <= best + slack && len <= static_cast<int>(search.path.moves.size()); len++){
+	search.run(cross::unpackIndex(crossIdx), crossIdx, len, -1);
+    }
+    return res;
+}
+
+std::array<std::vector<moves::Sequence>, 24> CrossEnumerator::enumerateAll(const cross::EdgeLocations& edges, int slack, std::size_t limit) const {
+    const auto& tables = cross::orientationTables();
+    std::array<std::vector<moves::Sequence>, 24> res;
+    for(int o = 0; o < 24; o++){
+	res[o] = enumerate(cross::packIndex(cross::crossLocations(edges, tables[o])), slack, limit);
+    }
+    return res;
+}
@@ -0,0 +1,36 @@
+#ifndef CROSS_ENUMERATOR_H
+#define CROSS_ENUMERATOR_H
+
+#include <array>
+#include <cstddef>
+#include <vector>
+#include "CrossSymmetry.h"
+#include "Moves.h"
+
+/*
+ * Every cross solution of optimal length, and optionally up to `slack`
+ * moves longer, instead of the single one stored in the table.
+ *
+ * The search walks the cross distance table, so it only ever steps to
+ * states still solvable in the moves left. Sequences are canonical
+ * (no repeated face, commuting opposite faces in one fixed order), so
+ * the same solution never shows up twice. Longer solutions must not pass
+ * through the solved cross early and every move has to change the cross
+ * state, which filters padding like a trailing U.
+ */
+class CrossEnumerator {
+public:
+    //Constructor: uses the shared cross::distanceTable()
+    CrossEnumerator();
+
+    //Solutions for one base-24 cross index, shortest first, at most `limit` of them
+    std::vector<moves::Sequence> enumerate(std::size_t crossIdx, int slack = 0, std::size_t limit = 10000) const;
+
+    //Same for every entry in cross::ORIENTATIONS, moves in that orientation's frame
+    std::array<std::vector<moves::Sequence>, 24> enumerateAll(const cross::EdgeLocations& edges, int slack = 0, std::size_t limit = 10000) const;
+
+private:
+    const std::vector<std::uint8_t>& dist_;
+};
+
+#endif
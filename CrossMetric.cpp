@@ -0,0 +1,173 @@
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <mutex>
+
+#include "CrossMetric.h"
+#include "CrossCoords.h"
+#include "CrossDistance.h"
+
+namespace {
+
+    constexpr std::uint16_t INF = std::numeric_limits<std::uint16_t>::max();
+
+    std::vector<std::uint16_t> buildWeighted(const cross::MoveCosts& costs){
+	const cross::MoveTable& next = cross::edgeMoveTable();
+	std::vector<std::uint16_t> dist(cross::STATES, INF);
+
+	// Dial's algorithm: one bucket per distance value
+	std::vector<std::vector<std::size_t>> buckets(1);
+	dist[cross::SOLVED_INDEX] = 0;
+	buckets[0].push_back(cross::SOLVED_INDEX);
+
+	for(std::size_t d = 0; d < buckets.size(); d++){
+	    for(std::size_t i = 0; i < buckets[d].size(); i++){
+		std::size_t u = buckets[d][i];
+		if(dist[u] != d) continue;
+		std::array<int, 4> pos = cross::unpackIndex(u);
+		for(int m = 0; m < moves::COUNT; m++){
+		    if(costs[m] == 0) continue;
+		    // v --m--> u, so v is u undone by m
+		    std::size_t v = cross::packIndex(cross::applyMove(pos, moves::inverse(m), next));
+		    std::size_t nd = d + costs[m];
+		    if(nd >= INF || nd >= dist[v]) continue;
+		    dist[v] = static_cast<std::uint16_t>(nd);
+		    if(buckets.size() <= nd) buckets.resize(nd + 1);
+		    buckets[nd].push_back(v);
+		}
+	    }
+	    std::vector<std::size_t>().swap(buckets[d]);
+	}
+	return dist;
+    }
+
+    std::shared_ptr<const std::vector<std::uint16_t>> cachedTable(const cross::MoveCosts& costs){
+	static std::mutex mtx;
+	static std::map<cross::MoveCosts, std::shared_ptr<const std::vector<std::uint16_t>>> cache;
+
+	std::lock_guard<std::mutex> lock(mtx);
+	auto it = cache.find(costs);
+	if(it != cache.end()) return it->second;
+	auto table = std::make_shared<const std::vector<std::uint16_t>>(buildWeighted(costs));
+	cache.emplace(costs, table);
+	return table;
+    }
+}
+
+bool cross::metricCosts(std::string_view metric, MoveCosts& out){
+    if(metric == "htm" || metric == "stm"){
+	out.fill(1);
+	return true;
+    }
+    if(metric == "qtm"){
+	for(int m = 0; m < moves::COUNT; m++){
+	    out[m] = moves::turn(m) == 2 ? 2 : 1;
+	}
+	return true;
+    }
+    return false;
+}
+
+bool cross::applyCostOverrides(std::string_view spec, MoveCosts& out){
+    MoveCosts res = out;
+    while(!spec.empty()){
+	std::size_t comma = spec.find(',');
+	std::string_view item = spec.substr(0, comma);
+	spec = comma == std::string_view::npos ? std::string_view{} : spec.substr(comma + 1);
+	if(item.empty()) continue;
+
+	std::size_t eq = item.find('=');
+	if(eq == std::string_view::npos) return false;
+	int move = moves::fromName(item.substr(0, eq));
+	std::string_view value = item.substr(eq + 1);
+	if(move < 0 || value.empty()) return false;
+
+	if(value == "x"){
+	    res[move] = 0;
+	    continue;
+	}
+	int cost = 0;
+	for(char ch : value){
+	    if(ch < '0' || ch > '9') return false;
+	    cost = cost * 10 + (ch - '0');
+	    if(cost > 255) return false;
+	}
+	if(cost == 0) return false;
+	res[move] = static_cast<std::uint8_t>(cost);
+    }
+    out = res;
+    return true;
+}
+
+cross::WeightedCrossSolver::WeightedCrossSolver(const MoveCosts& costs) : costs_(costs), dist_(cachedTable(costs)) {}
+
+cross::WeightedCrossSolver::Result cross::WeightedCrossSolver::solve(std::size_t crossIdx) const {
+    const std::vector<std::uint16_t>& dist = *dist_;
+    const MoveTable& next = edgeMoveTable();
+    Result res;
+    if(dist[crossIdx] == INF){
+	res.cost = -1;
+	return res;
+    }
+    res.cost = dist[crossIdx];
+
+    std::array<int, 4> pos = unpackIndex(crossIdx);
+    std::size_t idx = crossIdx;
+    while(dist[idx] > 0){
+	// never cut the path short and still report its full cost
+	bool stepped = false;
+	if(res.moves.length == res.moves.moves.size()){
+	    res.moves.length = 0;
+	    res.truncated = true;
+	    return res;
+	}
+	for(int m = 0; m < moves::COUNT; m++){
+	    if(costs_[m] == 0) continue;
+	    std::array<int, 4> moved = applyMove(pos, m, next);
+	    std::size_t t = packIndex(moved);
+	    if(dist[t] != INF && dist[t] + costs_[m] == dist[idx]){
+		// X X at the same total cost reads better as X2
+		std::uint8_t& len = res.moves.length;
+		int half = 3 * moves::face(m) + 2;
+		if(len > 0 && res.moves.moves[len - 1] == m && moves::turn(m) != 2 &&
+		   costs_[half] != 0 && costs_[half] == 2 * costs_[m]){
+		    res.moves.moves[len - 1] = static_cast<std::uint8_t>(half);
+		} else {
+		    res.moves.moves[len++] = static_cast<std::uint8_t>(m);
+		}
+		pos = moved;
+		idx = t;
+		stepped = true;
+		break;
+	    }
+	}
+	if(!stepped){
+	    // a consistent table always has a step down, don't spin on a broken one
+	    res.moves.length = 0;
+	    res.truncated = true;
+	    return res;
+	}
+    }
+    return res;
+}
+
+std::array<cross::WeightedCrossSolver::Result, 24> cross::WeightedCrossSolver::solveAll(const EdgeLocations& edges) const {
+    const auto& tables = orientationTables();
+    std::array<Result, 24> res;
+    for(int o = 0; o < 24; o++){
+	res[o] = solve(packIndex(crossLocations(edges, tables[o])));
+    }
+    return res;
+}
+
+std::array<int, 24> cross::WeightedCrossSolver::sortedByCost(const std::array<Result, 24>& results){
+    std::array<int, 24> order;
+    for(int i = 0; i < 24; i++) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b){
+	// unsolvable ones last
+	unsigned ca = static_cast<unsigned>(results[a].cost);
+	unsigned cb = static_cast<unsigned>(results[b].cost);
+	return ca < cb;
+    });
+    return order;
+}
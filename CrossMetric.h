@@ -0,0 +1,68 @@
+#ifndef CROSS_METRIC_H
+#define CROSS_METRIC_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "CrossSymmetry.h"
+#include "Moves.h"
+
+namespace cross {
+
+    /*
+     * Cost of every move code, 0 meaning the move may not be used.
+     *   htm / stm - every turn costs 1 (with only face turns available, STM
+     *               and HTM agree: there are no slice moves to count once)
+     *   qtm       - quarter turns 1, half turns 2
+     */
+    using MoveCosts = std::array<std::uint8_t, moves::COUNT>;
+
+    // false for an unknown metric name
+    bool metricCosts(std::string_view metric, MoveCosts& out);
+
+    /*
+     * Per-move overrides on top of a metric, comma separated:
+     *   "B=2,B'=2,D'=3"   make B turns and D' more expensive
+     *   "B2=x"            never use B2
+     * Returns false (leaving out untouched) on a malformed spec.
+     */
+    bool applyCostOverrides(std::string_view spec, MoveCosts& out);
+
+    /*
+     * Cheapest cross under an arbitrary cost vector. The distance table is a
+     * reverse Dijkstra (bucket queue, costs are small integers) from the
+     * solved cross, so following it is provably optimal for those costs.
+     * Tables are cached per cost vector for the life of the process.
+     */
+    class WeightedCrossSolver {
+    public:
+	struct Result {
+	    moves::Sequence moves;
+	    int cost = 0;		//-1 when the allowed moves can't solve it
+	    bool truncated = false;	//the cheapest path has more moves than a Sequence holds, moves are left empty
+	};
+
+	//Constructor: builds or reuses the distance table for these costs
+	explicit WeightedCrossSolver(const MoveCosts& costs);
+
+	Result solve(std::size_t crossIdx) const;
+
+	//One entry per cross::ORIENTATIONS, moves in that orientation's frame
+	std::array<Result, 24> solveAll(const EdgeLocations& edges) const;
+
+	//Orientation indices ordered by cost (ties keep ORIENTATIONS order)
+	static std::array<int, 24> sortedByCost(const std::array<Result, 24>& results);
+
+	int moveCost(int move) const { return costs_[move]; }
+
+    private:
+	MoveCosts costs_;
+	std::shared_ptr<const std::vector<std::uint16_t>> dist_;
+    };
+}
+
+#endif
@@ -0,0 +1,228 @@
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "CrossRecordFile.h"
+#include "CrossCoords.h"
+#include "CrossDistance.h"
+#include "MoveParser.h"
+
+namespace {
+    constexpr char MAGIC[8] = {'X', 'C', 'R', 'E', 'C', 'S', '\0', '\0'};
+
+    static_assert(sizeof(cross::RecordFileHeader) == 32, "header layout changed, bump RECORD_FILE_VERSION");
+    static_assert(sizeof(cross::CrossRecord) == 176, "record layout changed, bump RECORD_FILE_VERSION");
+    static_assert(offsetof(cross::CrossRecord, solution) % 4 == 0, "solution ids must stay aligned");
+
+    // records per write()
+    constexpr std::size_t kBufferRecords = 512;
+
+    bool checkHeader(const cross::RecordFileHeader& h, std::string& error){
+	if(std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0){
+	    error = "not a cross record file";
+	    return false;
+	}
+	if(h.version != cross::RECORD_FILE_VERSION || h.recordSize != sizeof(cross::CrossRecord)){
+	    error = "record version " + std::to_string(h.version) + ", expected " + std::to_string(cross::RECORD_FILE_VERSION);
+	    return false;
+	}
+	return true;
+    }
+}
+
+namespace cross {
+
+    bool validRecord(const CrossRecord& r){
+	for(std::uint8_t l : r.edges){
+	    if(l >= 24) return false;
+	}
+	for(std::uint8_t l : r.corners){
+	    if(l >= 24) return false;
+	}
+	for(const auto& pos : r.cross){
+	    for(std::uint8_t l : pos){
+		if(l >= 24) return false;
+	    }
+	}
+	for(int o = 0; o < 24; o++){
+	    if(r.solution[o] >= STATES || r.length[o] > RECORD_MAX_LENGTH) return false;
+	}
+	if(r.flags & ~RECORD_INVALID) return false;
+	if(r.flags & RECORD_INVALID){
+	    return r.parseError == static_cast<std::uint8_t>(ParseError::UNKNOWN_CHARACTER) ||
+		   r.parseError == static_cast<std::uint8_t>(ParseError::TOO_MANY_MOVES);
+	}
+	return r.parseError == 0;
+    }
+
+    std::string recordError(const CrossRecord& r){
+	return describeError(static_cast<ParseError>(r.parseError), r.errorPos, r.badChar);
+    }
+
+    CrossRecord makeRecord(const EdgeLocations& edges, const CornerLocations& corners){
+	const auto& tables = orientationTables();
+	const std::uint8_t* dist = distanceTable().data();
+	CrossRecord r{};
+	r.edges = edges;
+	r.corners = corners;
+	r.best = 0xFF;
+	for(int o = 0; o < 24; o++){
+	    std::array<int, 4> pos = crossLocations(edges, tables[o]);
+	    std::size_t idx = packIndex(pos);
+	    r.solution[o] = static_cast<std::uint32_t>(idx);
+	    r.length[o] = dist[idx];
+	    if(r.length[o] < r.best) r.best = r.length[o];
+	    if(o % 4 == 0){
+		for(int k = 0; k < 4; k++) r.cross[o / 4][k] = static_cast<std::uint8_t>(pos[k]);
+	    }
+	}
+	return r;
+    }
+
+    RecordWriter::RecordWriter(std::ostream& out) : out_(out) {
+	RecordFileHeader h{};
+	std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+	h.version = RECORD_FILE_VERSION;
+	h.recordSize = sizeof(CrossRecord);
+	buf_.reserve(kBufferRecords * sizeof(CrossRecord));
+	buf_.append(reinterpret_cast<const char*>(&h), sizeof(h));
+    }
+
+    RecordWriter::~RecordWriter(){
+	flush();
+    }
+
+    void RecordWriter::write(const CrossRecord& r){
+	buf_.append(reinterpret_cast<const char*>(&r), sizeof(r));
+	++count_;
+	if(buf_.size() >= kBufferRecords * sizeof(CrossRecord)) flush();
+    }
+
+    bool RecordWriter::flush(){
+	if(!buf_.empty()){
+	    out_.write(buf_.data(), static_cast<std::streamsize>(buf_.size()));
+	    buf_.clear();
+	}
+	out_.flush();
+	return static_cast<bool>(out_);
+    }
+
+    bool RecordReader::next(CrossRecord& r){
+	if(!error_.empty()) return false;
+	if(!started_){
+	    started_ = true;
+	    RecordFileHeader h;
+	    if(!in_.read(reinterpret_cast<char*>(&h), sizeof(h))){
+		error_ = "missing record file header";
+		return false;
+	    }
+	    if(!checkHeader(h, error_)) return false;
+	}
+	in_.read(reinterpret_cast<char*>(&r), sizeof(r));
+	if(in_.gcount() == 0) return false;
+	++count_;
+	if(in_.gcount() != static_cast<std::streamsize>(sizeof(r))){
+	    error_ = "truncated record at " + std::to_string(count_);
+	    return false;
+	}
+	if(!validRecord(r)){
+	    error_ = "bad record at " + std::to_string(count_);
+	    return false;
+	}
+	return true;
+    }
+
+    std::unique_ptr<MappedRecordFile> MappedRecordFile::open(const std::string& path, std::string& error, bool verifyRecords){
+	int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if(fd < 0){
+	    error = "cannot open " + path;
+	    return nullptr;
+	}
+	struct stat st;
+	if(fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(RecordFileHeader)){
+	    ::close(fd);
+	    error = path + " is too small to be a record file";
+	    return nullptr;
+	}
+	std::size_t size = static_cast<std::size_t>(st.st_size);
+	void* p = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);
+	if(p == MAP_FAILED){
+	    error = "cannot map " + path;
+	    return nullptr;
+	}
+	// scans go front to back, so let the kernel read ahead
+	madvise(p, size, MADV_SEQUENTIAL);
+
+	std::unique_ptr<MappedRecordFile> f(new MappedRecordFile());
+	f->data_ = static_cast<const unsigned char*>(p);
+	f->size_ = size;
+
+	const RecordFileHeader& h = *reinterpret_cast<const RecordFileHeader*>(f->data_);
+	if(!checkHeader(h, error)){
+	    error = path + ": " + error;
+	    return nullptr;
+	}
+	if((size - sizeof(RecordFileHeader)) % sizeof(CrossRecord) != 0){
+	    error = path + " is truncated";
+	    return nullptr;
+	}
+	f->records_ = reinterpret_cast<const CrossRecord*>(f->data_ + sizeof(RecordFileHeader));
+	f->count_ = (size - sizeof(RecordFileHeader)) / sizeof(CrossRecord);
+	if(verifyRecords){
+	    std::size_t bad = f->firstInvalid();
+	    if(bad < f->count_){
+		error = path + ": bad record at " + std::to_string(bad + 1);
+		return nullptr;
+	    }
+	}
+	return f;
+    }
+
+    std::size_t MappedRecordFile::firstInvalid() const noexcept {
+	for(std::size_t i = 0; i < count_; i++){
+	    if(!validRecord(records_[i])) return i;
+	}
+	return count_;
+    }
+
+    MappedRecordFile::~MappedRecordFile(){
+	if(data_) munmap(const_cast<unsigned char*>(data_), size_);
+    }
+
+    ConvertStats convertScrambles(std::istream& in, RecordWriter& out){
+	const MoveTable& edgeMoves = edgeMoveTable();
+	const MoveTable& cornerMoves = cornerMoveTable();
+	ConvertStats stats;
+	std::uint8_t codes[MAX_SCRAMBLE_MOVES];
+	std::string line;
+	while(std::getline(in, line)){
+	    if(!line.empty() && line.back() == '\r') line.pop_back();
+	    EdgeLocations edges = SOLVED_EDGES;
+	    CornerLocations corners = SOLVED_CORNERS;
+	    ParseResult parsed = parseMoves(line, codes, MAX_SCRAMBLE_MOVES);
+	    if(parsed.ok()){
+		for(std::size_t i = 0; i < parsed.count; i++){
+		    applyMove(edges, codes[i], edgeMoves);
+		    applyMove(corners, codes[i], cornerMoves);
+		}
+	    }
+	    CrossRecord r = makeRecord(edges, corners);
+	    if(!parsed.ok()){
+		r.flags |= RECORD_INVALID;
+		r.parseError = static_cast<std::uint8_t>(parsed.error);
+		r.errorPos = static_cast<std::uint32_t>(parsed.errorPos);
+		r.badChar = parsed.errorPos < line.size() ? line[parsed.errorPos] : ' ';
+		std::cerr << "line " << stats.records + 1 << ": " << describeError(parsed, line) << std::endl;
+		stats.invalid++;
+	    }
+	    out.write(r);
+	    stats.records++;
+	}
+	return stats;
+    }
+}
@@ -0,0 +1,146 @@
+#ifndef CROSS_RECORD_FILE_H
+#define CROSS_RECORD_FILE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include "CrossSymmetry.h"
+
+/*
+ * Solved scrambles as fixed-size binary records, so later stages of a
+ * pipeline neither re-parse scramble text nor re-solve anything:
+ *
+ *   header   (magic "XCRECS", version, record size)
+ *   CrossRecord records[n]   n from the file size, in input line order
+ *
+ * Native byte order, like the table file. Records are 8-byte aligned and
+ * never span anything else, so a mapped file is just an array of them.
+ */
+namespace cross {
+
+    constexpr std::uint32_t RECORD_FILE_VERSION = 2;
+
+    struct RecordFileHeader {
+	char magic[8];
+	std::uint32_t version;
+	std::uint32_t recordSize;
+	std::uint64_t reserved[2];
+    };
+
+    // CrossRecord::flags
+    constexpr std::uint8_t RECORD_INVALID = 1;	//the line didn't parse, the rest is the solved cube
+
+    // optimal crosses are never longer than this in face turns
+    constexpr std::uint8_t RECORD_MAX_LENGTH = 8;
+
+    struct CrossRecord {
+	EdgeLocations edges;	//full cube state
+	CornerLocations corners;
+	std::array<std::array<std::uint8_t, 4>, 6> cross;	//per cross colour, getCrossLocations() in orientation 4 * k (its first front)
+	std::array<std::uint8_t, 24> length;	//optimal cross per orientation, in ORIENTATIONS order
+	std::uint8_t best;
+	std::uint8_t flags;
+	std::uint8_t parseError;	//with RECORD_INVALID: the ParseError, the offending character and its offset
+	char badChar;
+	std::uint32_t errorPos;
+	std::array<std::uint32_t, 24> solution;	//packIndex per orientation, SolvingLogic::getCrossSolutionAt gives the moves
+	std::uint32_t reserved;
+    };
+
+    /*
+     * Every field in range (locations, solution ids, lengths), so nothing
+     * read from a file can index past a table. Readers reject the rest.
+     */
+    bool validRecord(const CrossRecord& r);
+
+    // why an invalid record's line didn't parse, as describeError() put it
+    std::string recordError(const CrossRecord& r);
+
+    // every field filled from the state (distance table lengths, no text)
+    CrossRecord makeRecord(const EdgeLocations& edges, const CornerLocations& corners);
+
+    // records to a stream in large writes, header first
+    class RecordWriter {
+    private:
+	std::ostream& out_;
+	std::string buf_;
+	std::size_t count_ = 0;
+
+    public:
+	//Constructor: writes the header
+	explicit RecordWriter(std::ostream& out);
+	RecordWriter(const RecordWriter&) = delete;
+	RecordWriter& operator=(const RecordWriter&) = delete;
+	~RecordWriter();
+
+	void write(const CrossRecord& r);
+	bool flush();
+	std::size_t count() const { return count_; }
+    };
+
+    // records back from a stream (a pipe is fine), header checked on the first read
+    class RecordReader {
+    private:
+	std::istream& in_;
+	std::string error_;
+	bool started_ = false;
+	std::size_t count_ = 0;
+
+    public:
+	//Constructor
+	explicit RecordReader(std::istream& in) : in_(in) {}
+
+	// false at the end of the stream or on an error (bad header, truncated or invalid record), error() tells them apart
+	bool next(CrossRecord& r);
+	const std::string& error() const { return error_; }
+    };
+
+    // a whole record file mapped read-only, for scanning
+    class MappedRecordFile {
+    private:
+	const unsigned char* data_ = nullptr;
+	std::size_t size_ = 0;
+	const CrossRecord* records_ = nullptr;
+	std::size_t count_ = 0;
+
+	MappedRecordFile() = default;
+
+    public:
+	/*
+	 * Maps and checks the header and size. Checking every record with
+	 * validRecord() means reading the whole file, so it's only done with
+	 * verifyRecords (or firstInvalid()); otherwise a caller that indexes a
+	 * table with a record's fields checks that record first.
+	 * Returns nullptr and fills `error` on any problem.
+	 */
+	static std::unique_ptr<MappedRecordFile> open(const std::string& path, std::string& error, bool verifyRecords = false);
+	~MappedRecordFile();
+	MappedRecordFile(const MappedRecordFile&) = delete;
+	MappedRecordFile& operator=(const MappedRecordFile&) = delete;
+
+	// index of the first record that fails validRecord(), size() when they all pass
+	std::size_t firstInvalid() const noexcept;
+	std::size_t size() const noexcept { return count_; }
+	const CrossRecord* begin() const noexcept { return records_; }
+	const CrossRecord* end() const noexcept { return records_ + count_; }
+	const CrossRecord& operator[](std::size_t i) const noexcept { return records_[i]; }
+    };
+
+    struct ConvertStats {
+	std::size_t records = 0;
+	std::size_t invalid = 0;
+    };
+
+    /*
+     * One scramble per line (the --batch input) to one record per line. Lines
+     * that don't parse still get a record, flagged RECORD_INVALID, so record
+     * i is always line i; the reason goes to std::cerr.
+     */
+    ConvertStats convertScrambles(std::istream& in, RecordWriter& out);
+}
+
+#endif
@@ -0,0 +1,50 @@
+#include "CrossSolverApi.h"
+#include "CrossSymmetry.h"
+#include "MoveParser.h"
+#include "SolvingLogic.h"
+
+namespace {
+    // the orientation frames are built (through Cube, which allocates) when the
+    // library is loaded, so no solveAll call ever pays for it
+    const bool framesReady = !cross::orientationTables().empty();
+}
+
+cross::SolveStatus cross::solveAll(const EdgeLocations& loc, Solution (&out)[24]) noexcept {
+    if(!SolvingLogic::hasTable()) return SolveStatus::NO_TABLE;
+    const auto& tables = orientationTables();
+    for(int i = 0; i < 24; i++){
+	std::string_view s = SolvingLogic::getCrossSolution(crossLocations(loc, tables[i]));
+	out[i] = {s, numMoves(s)};
+    }
+    return SolveStatus::OK;
+}
+
+cross::SolveStatus cross::solveAll(const std::uint8_t* moves, std::size_t count, Solution (&out)[24]) noexcept {
+    EdgeLocations loc = SOLVED_EDGES;
+    applyMoves(loc, moves, count);
+    return solveAll(loc, out);
+}
+
+cross::SolveStatus cross::solveAll(std::string_view scramble, Solution (&out)[24], std::size_t* errorPos) noexcept {
+    std::uint8_t codes[MAX_SCRAMBLE_MOVES];
+    ParseResult parsed = parseMoves(scramble, codes, MAX_SCRAMBLE_MOVES);
+    if(!parsed.ok()){
+	if(errorPos) *errorPos = parsed.errorPos;
+	return parsed.error == ParseError::TOO_MANY_MOVES ? SolveStatus::TOO_MANY_MOVES : SolveStatus::BAD_SCRAMBLE;
+    }
+    return solveAll(codes, parsed.count, out);
+}
+
+bool cross::loadTableFile(const std::string& path, std::string& error, bool verify){
+    return SolvingLogic::useTableFile(path, error, verify);
+}
+
+const char* cross::statusString(SolveStatus s) noexcept {
+    switch(s){
+	case SolveStatus::OK: return "ok";
+	case SolveStatus::BAD_SCRAMBLE: return "not a move";
+	case SolveStatus::TOO_MANY_MOVES: return "too many moves";
+	case SolveStatus::NO_TABLE: return "no cross table loaded";
+    }
+    return "unknown status";
+}
@@ -0,0 +1,52 @@
+#ifndef CROSS_SOLVER_API_H
+#define CROSS_SOLVER_API_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "CrossCoords.h"
+
+/*
+ * Embedding API of libcrosssolver: scramble in, optimal cross for all 24
+ * orientations out, with nothing else to set up.
+ *
+ * solveAll() only reads static tables: it is reentrant and thread-safe,
+ * never throws and never touches the heap. The move text is a view into the
+ * cross table and stays valid for the life of the process (or until the
+ * table file is unloaded, which never happens). Solutions come in
+ * cross::ORIENTATIONS order.
+ */
+namespace cross {
+
+    struct Solution {
+	std::string_view moves;	//e.g. "D2 F R'", empty when the cross is solved
+	int length;		//move count
+    };
+
+    enum class SolveStatus {
+	OK,
+	BAD_SCRAMBLE,		//something that isn't a move, see errorPos
+	TOO_MANY_MOVES,		//over MAX_SCRAMBLE_MOVES
+	NO_TABLE		//built without the compiled-in table and no file loaded
+    };
+
+    // scramble text as accepted by parseMoves; errorPos (if given) gets the offending column
+    SolveStatus solveAll(std::string_view scramble, Solution (&out)[24], std::size_t* errorPos = nullptr) noexcept;
+
+    // move codes as in moves::Move
+    SolveStatus solveAll(const std::uint8_t* moves, std::size_t count, Solution (&out)[24]) noexcept;
+
+    SolveStatus solveAll(const EdgeLocations& loc, Solution (&out)[24]) noexcept;
+
+    /*
+     * Optional setup, not thread-safe: answer from a table file instead of
+     * the compiled-in table (see SolvingLogic::useTableFile). Call before
+     * the first solveAll.
+     */
+    bool loadTableFile(const std::string& path, std::string& error, bool verify = false);
+
+    const char* statusString(SolveStatus s) noexcept;
+}
+
+#endif
@@ -0,0 +1,56 @@
+#include <cstring>
+#include <string>
+
+#include "CrossSolverC.h"
+#include "CrossSolverApi.h"
+#include "OutputFormat.h"
+
+static_assert(CROSS_OK == static_cast<int>(cross::SolveStatus::OK) && CROSS_BAD_SCRAMBLE == static_cast<int>(cross::SolveStatus::BAD_SCRAMBLE)
+	      && CROSS_TOO_MANY_MOVES == static_cast<int>(cross::SolveStatus::TOO_MANY_MOVES) && CROSS_NO_TABLE == static_cast<int>(cross::SolveStatus::NO_TABLE),
+	      "C status codes out of sync with cross::SolveStatus");
+
+extern "C" int cross_solve_all(const char* scramble, size_t len, cross_solution out[CROSS_ORIENTATIONS], size_t* error_pos){
+    cross::Solution sols[24];
+    cross::SolveStatus st = cross::solveAll(std::string_view(scramble, len), sols, error_pos);
+    if(st != cross::SolveStatus::OK) return static_cast<int>(st);
+    for(int i = 0; i < 24; i++){
+	out[i].moves = sols[i].moves.data();
+	out[i].moves_len = sols[i].moves.size();
+	out[i].length = sols[i].length;
+    }
+    return CROSS_OK;
+}
+
+extern "C" int cross_orientation_colours(int o, char* cross, char* front){
+    if(o < 0 || o >= CROSS_ORIENTATIONS) return 0;
+    if(cross) *cross = crossColour(o);
+    if(front) *front = frontColour(o);
+    return 1;
+}
+
+namespace {
+
+    void copyError(const std::string& error, char* err, size_t err_len){
+	if(!err || err_len == 0) return;
+	size_t n = error.size() < err_len - 1 ? error.size() : err_len - 1;
+	std::memcpy(err, error.data(), n);
+	err[n] = '\0';
+    }
+}
+
+extern "C" int cross_load_table_file(const char* path, int verify, char* err, size_t err_len){
+    // nothing may escape into C
+    try {
+	std::string error;
+	if(cross::loadTableFile(path, error, verify != 0)) return CROSS_OK;
+	copyError(error, err, err_len);
+    } catch(...) {
+	copyError("cannot load the table file", err, err_len);
+    }
+    return CROSS_NO_TABLE;
+}
+
+extern "C" const char* cross_status_string(int status){
+    if(status < CROSS_OK || status > CROSS_NO_TABLE) return "unknown status";
+    return cross::statusString(static_cast<cross::SolveStatus>(status));
+}
@@ -0,0 +1,56 @@
+#ifndef CROSS_SOLVER_C_H
+#define CROSS_SOLVER_C_H
+
+/*
+ * C ABI of libcrosssolver, a thin wrapper over cross::solveAll
+ * (CrossSolverApi.h) with the same guarantees: reentrant, thread-safe and
+ * allocation-free. Link with -lcrosssolver (plus -lstdc++ -pthread for the
+ * static library).
+ *
+ *   cross_solution sols[CROSS_ORIENTATIONS];
+ *   if(cross_solve_all("R U F'", 6, sols, NULL) == CROSS_OK)
+ *       printf("%.*s\n", (int)sols[7].moves_len, sols[7].moves);
+ *
+ * moves is not NUL-terminated and points into the library's table.
+ */
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CROSS_ORIENTATIONS 24
+
+enum {
+    CROSS_OK = 0,
+    CROSS_BAD_SCRAMBLE = 1,
+    CROSS_TOO_MANY_MOVES = 2,
+    CROSS_NO_TABLE = 3
+};
+
+typedef struct {
+    const char* moves;
+    size_t moves_len;
+    int length;		/* move count */
+} cross_solution;
+
+/* one solution per orientation; error_pos (may be NULL) gets the column of a bad move */
+int cross_solve_all(const char* scramble, size_t len, cross_solution out[CROSS_ORIENTATIONS], size_t* error_pos);
+
+/* cross (down) and front centre colour letters of orientation o, 0 if o is out of range */
+int cross_orientation_colours(int o, char* cross, char* front);
+
+/*
+ * answer from a table file written by cross-table-gen --binary, CROSS_OK or
+ * CROSS_NO_TABLE; call before solving. On failure the reason is copied into
+ * err (may be NULL), cut to err_len - 1 bytes and NUL-terminated.
+ */
+int cross_load_table_file(const char* path, int verify, char* err, size_t err_len);
+
+const char* cross_status_string(int status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
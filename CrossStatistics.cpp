@@ -0,0 +1,312 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "CrossStatistics.h"
+#include "CompactCrossTable.h"
+#include "CrossDistance.h"
+#include "CrossSymmetry.h"
+
+namespace {
+
+    // one frame per colour: the unrotated Down frame first, then Up, then the four sides
+    constexpr int DOWN_FRAME = 7;
+    constexpr std::array<int, 6> FRAMES{{DOWN_FRAME, 3, 8, 12, 16, 20}};
+    constexpr int COLOURS = 6;
+    constexpr int FREE = 8;	//edges outside the Down cross
+
+    /*
+     * Every edge piece is in exactly two colours' crosses. Placing piece p at
+     * location l adds add[p][l][j] to the index of colour colour[p][j].
+     */
+    struct Contributions {
+	std::array<std::array<std::uint8_t, 2>, 12> colour;
+	std::array<std::array<std::array<std::uint32_t, 2>, 24>, 12> add;
+    };
+
+    const Contributions& contributions(){
+	static const Contributions table = []{
+	    Contributions t{};
+	    std::array<int, 12> seen{};
+	    const auto& frames = cross::orientationTables();
+	    for(int c = 0; c < COLOURS; c++){
+		const cross::OrientationTable& f = frames[FRAMES[c]];
+		std::uint32_t weight = 1;
+		for(int k = 0; k < 4; k++){
+		    int piece = f.crossEdge[k] >> 1;
+		    int side = f.crossEdge[k] & 1;
+		    int j = seen[piece]++;
+		    t.colour[piece][j] = static_cast<std::uint8_t>(c);
+		    for(int l = 0; l < 24; l++) t.add[piece][l][j] = f.relabel[l ^ side] * weight;
+		    weight *= static_cast<std::uint32_t>(cross::BASE);
+		}
+	    }
+	    return t;
+	}();
+	return table;
+    }
+
+    struct Walker {
+	const Contributions& con;
+	const std::uint8_t* dist;
+	std::array<int, FREE> pieces;
+	std::array<std::array<std::uint64_t, CrossStatistics::DEPTHS>, CrossStatistics::DEPTHS>& joint;
+
+	void leaf(const std::array<std::uint32_t, COLOURS>& idx){
+	    int d0 = dist[idx[0]];
+	    int d1 = dist[idx[1]];
+	    int dual = std::min(d0, d1);
+	    int best = dual;
+	    for(int c = 2; c < COLOURS; c++) best = std::min<int>(best, dist[idx[c]]);
+	    ++joint[dual][best];
+	}
+
+	// pieces[i..] still to place into freeSlots, parity = flips so far
+	void walk(int i, const std::array<std::uint32_t, COLOURS>& idx, unsigned freeSlots, unsigned parity){
+	    int p = pieces[i];
+	    const auto& colour = con.colour[p];
+	    if(i == FREE - 1){
+		// one slot left and the flip has to make the total even
+		int l = 2 * __builtin_ctz(freeSlots) + static_cast<int>(parity);
+		std::array<std::uint32_t, COLOURS> n = idx;
+		n[colour[0]] += con.add[p][l][0];
+		n[colour[1]] += con.add[p][l][1];
+		leaf(n);
+		return;
+	    }
+	    for(unsigned rest = freeSlots; rest; rest &= rest - 1){
+		int s = __builtin_ctz(rest);
+		for(int f = 0; f < 2; f++){
+		    int l = 2 * s + f;
+		    std::array<std::uint32_t, COLOURS> n = idx;
+		    n[colour[0]] += con.add[p][l][0];
+		    n[colour[1]] += con.add[p][l][1];
+		    walk(i + 1, n, freeSlots & ~(1u << s), parity ^ static_cast<unsigned>(f));
+		}
+	    }
+	}
+    };
+
+    std::uint64_t fnv1a(const std::vector<std::uint8_t>& data){
+	std::uint64_t h = 14695981039346656037ULL;
+	for(std::uint8_t b : data){
+	    h ^= b;
+	    h *= 1099511628211ULL;
+	}
+	return h;
+    }
+
+    constexpr const char* CHECKPOINT_MAGIC = "cross-statistics";
+    constexpr int CHECKPOINT_VERSION = 1;
+
+    bool loadCheckpoint(const std::string& path, std::size_t classes, std::uint64_t tableHash, CrossStatistics::Histograms& h, std::size_t& done){
+	std::ifstream in(path);
+	if(!in) return false;
+	std::string magic;
+	int version = 0;
+	std::size_t fileClasses = 0;
+	std::uint64_t fileHash = 0;
+	std::size_t fileDone = 0;
+	in >> magic >> version >> fileClasses >> fileHash >> fileDone;
+	if(!in || magic != CHECKPOINT_MAGIC || version != CHECKPOINT_VERSION || fileClasses != classes || fileHash != tableHash || fileDone > classes){
+	    return false;
+	}
+	CrossStatistics::Histograms loaded;
+	for(std::uint64_t& v : loaded.single) in >> v;
+	for(auto& row : loaded.joint){
+	    for(std::uint64_t& v : row) in >> v;
+	}
+	if(!in) return false;
+	h = loaded;
+	done = fileDone;
+	return true;
+    }
+
+    bool saveCheckpoint(const std::string& path, std::size_t classes, std::uint64_t tableHash, const CrossStatistics::Histograms& h, std::size_t done){
+	std::string tmp = path + ".tmp";
+	{
+	    std::ofstream out(tmp, std::ios::trunc);
+	    if(!out) return false;
+	    out << CHECKPOINT_MAGIC << ' ' << CHECKPOINT_VERSION << '\n' << classes << ' ' << tableHash << ' ' << done << '\n';
+	    for(std::uint64_t v : h.single) out << v << ' ';
+	    out << '\n';
+	    for(const auto& row : h.joint){
+		for(std::uint64_t v : row) out << v << ' ';
+		out << '\n';
+	    }
+	    if(!out) return false;
+	}
+	return std::rename(tmp.c_str(), path.c_str()) == 0;
+    }
+}
+
+void CrossStatistics::Histograms::add(const Histograms& o){
+    for(int d = 0; d < DEPTHS; d++){
+	single[d] += o.single[d];
+	for(int e = 0; e < DEPTHS; e++) joint[d][e] += o.joint[d][e];
+    }
+}
+
+std::uint64_t CrossStatistics::Histograms::total() const {
+    std::uint64_t t = 0;
+    for(std::uint64_t v : single) t += v;
+    return t;
+}
+
+CrossStatistics::CrossStatistics() : dist_(cross::STATES) {
+    for(std::size_t idx = 0; idx < cross::STATES; idx++) dist_[idx] = cross::compactDistance(idx);
+    tableHash_ = fnv1a(dist_);
+
+    // Down crosses seen from the four y-rotated Down frames, smallest index of each orbit stands for it
+    const auto& frames = cross::orientationTables();
+    const cross::OrientationTable& down = frames[DOWN_FRAME];
+    for(std::size_t idx = 0; idx < cross::STATES; idx++){
+	if(dist_[idx] == cross::COMPACT_UNREACHED) continue;
+	std::array<int, 4> pos = cross::unpackIndex(idx);
+	cross::EdgeLocations loc{};
+	for(int k = 0; k < 4; k++) loc[down.crossEdge[k] >> 1] = static_cast<std::uint8_t>(pos[k] ^ (down.crossEdge[k] & 1));
+
+	std::array<std::size_t, 4> orbit;
+	for(int r = 0; r < 4; r++) orbit[r] = cross::packIndex(cross::crossLocations(loc, frames[4 + r]));
+	std::sort(orbit.begin(), orbit.end());
+	if(orbit[0] != idx) continue;
+	int weight = static_cast<int>(std::unique(orbit.begin(), orbit.end()) - orbit.begin());
+	classes_.push_back({static_cast<std::uint32_t>(idx), static_cast<std::uint8_t>(weight)});
+    }
+}
+
+CrossStatistics::Histograms CrossStatistics::runClass(std::size_t c) const {
+    const Contributions& con = contributions();
+    const cross::OrientationTable& down = cross::orientationTables()[DOWN_FRAME];
+    std::array<int, 4> pos = cross::unpackIndex(classes_[c].index);
+
+    // the Down cross pieces are fixed, their share of every colour's index is too
+    std::array<std::uint32_t, COLOURS> idx{};
+    std::array<bool, 12> fixed{};
+    unsigned freeSlots = (1u << 12) - 1;
+    unsigned parity = 0;
+    for(int k = 0; k < 4; k++){
+	int piece = down.crossEdge[k] >> 1;
+	int l = pos[k] ^ (down.crossEdge[k] & 1);
+	fixed[piece] = true;
+	freeSlots &= ~(1u << (l >> 1));
+	parity ^= static_cast<unsigned>(l & 1);
+	idx[con.colour[piece][0]] += con.add[piece][l][0];
+	idx[con.colour[piece][1]] += con.add[piece][l][1];
+    }
+
+    Histograms h;
+    Walker w{con, dist_.data(), {}, h.joint};
+    int n = 0;
+    for(int p = 0; p < 12; p++){
+	if(!fixed[p]) w.pieces[n++] = p;
+    }
+    w.walk(0, idx, freeSlots, parity);
+
+    std::uint64_t weight = classes_[c].weight;
+    std::uint64_t states = 0;
+    for(auto& row : h.joint){
+	for(std::uint64_t& v : row){
+	    states += v;
+	    v *= weight;
+	}
+    }
+    h.single[dist_[classes_[c].index]] = states * weight;
+    return h;
+}
+
+bool CrossStatistics::run(unsigned threads, const std::string& checkpoint, double checkpointSeconds, std::size_t stopAfter,
+			  Histograms& totals, std::size_t& done) const {
+    if(threads == 0) threads = 1;
+    if(!checkpoint.empty() && loadCheckpoint(checkpoint, classes_.size(), tableHash_, totals, done)){
+	std::cerr << "stats: resuming " << checkpoint << " at class " << done << " of " << classes_.size() << std::endl;
+    }
+    std::size_t end = classes_.size();
+    if(stopAfter > 0) end = std::min(end, done + stopAfter);
+
+    std::atomic<std::size_t> next(done);
+    std::mutex mtx;
+    std::map<std::size_t, Histograms> pending;	//finished out of order, waiting for the prefix
+    bool ok = true;
+    auto start = std::chrono::steady_clock::now();
+    auto lastSave = start;
+    std::size_t startDone = done;
+
+    auto worker = [&](){
+	for(;;){
+	    std::size_t c = next.fetch_add(1);
+	    if(c >= end) return;
+	    Histograms h = runClass(c);
+
+	    std::lock_guard<std::mutex> lock(mtx);
+	    pending.emplace(c, h);
+	    while(!pending.empty() && pending.begin()->first == done){
+		totals.add(pending.begin()->second);
+		pending.erase(pending.begin());
+		++done;
+	    }
+	    auto now = std::chrono::steady_clock::now();
+	    if(std::chrono::duration<double>(now - lastSave).count() >= checkpointSeconds){
+		lastSave = now;
+		double secs = std::chrono::duration<double>(now - start).count();
+		double rate = (done - startDone) / secs;
+		std::cerr << "stats: " << done << "/" << classes_.size() << " classes, " << std::fixed << std::setprecision(0)
+			  << (rate > 0.0 ? (end - done) / rate : 0.0) << " s left" << std::endl;
+		if(!checkpoint.empty() && !saveCheckpoint(checkpoint, classes_.size(), tableHash_, totals, done)) ok = false;
+	    }
+	}
+    };
+
+    std::vector<std::thread> pool;
+    for(unsigned t = 0; t < threads; t++) pool.emplace_back(worker);
+    for(std::thread& t : pool) t.join();
+
+    if(!checkpoint.empty() && !saveCheckpoint(checkpoint, classes_.size(), tableHash_, totals, done)) ok = false;
+    if(!ok) std::cerr << "stats: cannot write checkpoint " << checkpoint << std::endl;
+    return ok;
+}
+
+void CrossStatistics::printReport(std::ostream& out, const Histograms& h, std::size_t done, std::size_t classes){
+    std::array<std::uint64_t, DEPTHS> dual{};
+    std::array<std::uint64_t, DEPTHS> neutral{};
+    std::array<std::uint64_t, DEPTHS> gap{};
+    for(int d = 0; d < DEPTHS; d++){
+	for(int e = 0; e < DEPTHS; e++){
+	    dual[d] += h.joint[d][e];
+	    neutral[e] += h.joint[d][e];
+	    if(h.joint[d][e] > 0) gap[d - e] += h.joint[d][e];
+	}
+    }
+    std::uint64_t total = h.total();
+    double scale = total > 0 ? 100.0 / static_cast<double>(total) : 0.0;
+
+    out << "edge states: " << total << " (" << done << "/" << classes << " Down cross classes"
+	<< (done == classes ? ", complete" : ", partial") << ")" << std::endl;
+    out << std::setw(6) << std::left << "moves" << std::setw(28) << "one colour" << std::setw(28) << "dual (best of U/D)" << "colour neutral (best of 6)" << std::endl;
+    out << std::fixed << std::setprecision(4);
+    for(int d = 0; d < DEPTHS; d++){
+	if(h.single[d] == 0 && dual[d] == 0 && neutral[d] == 0) continue;
+	auto cell = [&](std::uint64_t v){
+	    std::string s = std::to_string(v);
+	    std::ostringstream pct;
+	    pct << std::fixed << std::setprecision(4) << v * scale;
+	    return s + " (" + pct.str() + "%)";
+	};
+	out << std::setw(6) << d << std::setw(28) << cell(h.single[d]) << std::setw(28) << cell(dual[d]) << cell(neutral[d]) << std::endl;
+    }
+    out << "dual - colour neutral:" << std::endl;
+    for(int d = 0; d < DEPTHS; d++){
+	if(gap[d] == 0) continue;
+	out << "  +" << d << ": " << gap[d] << " (" << gap[d] * scale << "%)" << std::endl;
+    }
+    out << "dual within one move of colour neutral: " << (gap[0] + gap[1]) * scale << "%" << std::endl;
+}
@@ -0,0 +1,65 @@
+#ifndef CROSS_STATISTICS_H
+#define CROSS_STATISTICS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/*
+ * Exact colour-neutral cross statistics over every edge state
+ * (12! * 2^11, corners don't matter for any cross).
+ *
+ * States are grouped by their Down cross. A y rotation maps the states with
+ * one Down cross onto the states with its conjugate, and leaves the Down
+ * cross distance, the Up/Down pair and the set of six colours alone, so only
+ * one Down cross per y-orbit is enumerated and its counts are weighted by
+ * the orbit size. For each of those the other 8 edges run through all
+ * 8! * 2^7 placements, with the six cross indices built up incrementally,
+ * and the six distances come from the same table the solver answers from.
+ */
+class CrossStatistics {
+public:
+    static constexpr int DEPTHS = 16;
+
+    struct Histograms {
+	std::array<std::uint64_t, DEPTHS> single{};				//one fixed colour
+	std::array<std::array<std::uint64_t, DEPTHS>, DEPTHS> joint{};	//[best of one opposite pair][best of six]
+
+	void add(const Histograms& o);
+	std::uint64_t total() const;
+    };
+
+    //Constructor: finds the Down cross classes
+    CrossStatistics();
+
+    std::size_t classCount() const { return classes_.size(); }
+
+    //Weighted counts for every edge state whose Down cross is in class c
+    Histograms runClass(std::size_t c) const;
+
+    /*
+     * Runs classes [done, classCount()) on `threads` workers, adding into
+     * `totals`. With a checkpoint path the finished prefix and totals are
+     * written there every `checkpointSeconds` and at the end, and an existing
+     * checkpoint is resumed from. stopAfter > 0 stops after that many more
+     * classes (the checkpoint then resumes where it stopped).
+     */
+    bool run(unsigned threads, const std::string& checkpoint, double checkpointSeconds, std::size_t stopAfter,
+	     Histograms& totals, std::size_t& done) const;
+
+    static void printReport(std::ostream& out, const Histograms& h, std::size_t done, std::size_t classes);
+
+private:
+    struct Class {
+	std::uint32_t index;	//Down cross, base-24 index in the unrotated frame
+	std::uint8_t weight;	//y-orbit size
+    };
+    std::vector<Class> classes_;
+    std::vector<std::uint8_t> dist_;	//distance per cross index, from the compact table
+    std::uint64_t tableHash_;
+};
+
+#endif
@@ -0,0 +1,29 @@
+#include "CrossSweep.h"
+#include "CompactCrossTable.h"
+#include "SolvingLogic.h"
+
+SweepResult sweepOrientations(const cross::EdgeLocations& loc){
+    const auto& tables = cross::orientationTables();
+    SweepResult res;
+    for(int i = 0; i < 24; i++){
+	res[i] = SolvingLogic::getCrossSolution(cross::crossLocations(loc, tables[i]));
+    }
+    return res;
+}
+
+SweepResult sweepOrientations(const CubieCube& cc){
+    return sweepOrientations(cc.edgeLocations());
+}
+
+SweepResult sweepOrientations(const Cube& c){
+    return sweepOrientations(cross::edgeLocations(c));
+}
+
+SweepSequences sweepOrientationsCompact(const cross::EdgeLocations& loc){
+    const auto& tables = cross::orientationTables();
+    SweepSequences res;
+    for(int i = 0; i < 24; i++){
+	res[i] = cross::compactSolution(cross::crossLocations(loc, tables[i]));
+    }
+    return res;
+}
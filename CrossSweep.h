@@ -0,0 +1,26 @@
+#ifndef CROSS_SWEEP_H
+#define CROSS_SWEEP_H
+
+#include <array>
+#include <string_view>
+#include "CrossSymmetry.h"
+#include "Cube.h"
+#include "CubieCube.h"
+#include "Moves.h"
+
+// Optimal cross for every orientation in cross::ORIENTATIONS, same order (views into the table)
+using SweepResult = std::array<std::string_view, 24>;
+
+/*
+ * The edge state is read once and every orientation is answered through
+ * cross::orientationTables(), no cube is copied or re-oriented.
+ */
+SweepResult sweepOrientations(const cross::EdgeLocations& loc);
+SweepResult sweepOrientations(const CubieCube& cc);
+SweepResult sweepOrientations(const Cube& c);
+
+// same sweep answered from the 4-bit compact table, solutions rebuilt per orientation
+using SweepSequences = std::array<moves::Sequence, 24>;
+SweepSequences sweepOrientationsCompact(const cross::EdgeLocations& loc);
+
+#endif
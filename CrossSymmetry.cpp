@@ -0,0 +1,140 @@
+#include <iostream>
+
+#include "CrossSymmetry.h"
+#include "CrossConstants.hpp"
+
+namespace {
+
+    char colorAt(const Cube& c, int i){
+	const auto& p = cross::EDGE_POSITIONS[i];
+	return c.getColorAtPosition(std::get<0>(p), std::get<1>(p), std::get<2>(p));
+    }
+
+    char cornerColorAt(const Cube& c, int i){
+	const auto& p = cross::CORNER_POSITIONS[i];
+	return c.getColorAtPosition(std::get<0>(p), std::get<1>(p), std::get<2>(p));
+    }
+
+    // neighbour of corner sticker i going clockwise within its corner
+    int nextInCorner(int i){
+	return 3 * (i / 3) + (i % 3 + 1) % 3;
+    }
+
+    // solved corner sticker showing a, with b and c following clockwise
+    int solvedCornerSticker(const Cube& solved, char a, char b, char c){
+	for(int s = 0; s < 24; s++){
+	    int s1 = nextInCorner(s);
+	    if(cornerColorAt(solved, s) == a && cornerColorAt(solved, s1) == b && cornerColorAt(solved, nextInCorner(s1)) == c) return s;
+	}
+	return -1;
+    }
+
+    // Face enum value -> moves::face index (R L U D F B)
+    constexpr int MOVE_FACE[6] = {2, 1, 4, 0, 5, 3};
+
+    // solved edge sticker carrying colours (a, b) with b on the partner, -1 if none
+    int solvedSticker(const Cube& solved, char a, char b){
+	for(int s = 0; s < 24; s++){
+	    if(colorAt(solved, s) == a && colorAt(solved, s ^ 1) == b) return s;
+	}
+	return -1;
+    }
+
+    /*
+     * Built once by orienting a solved cube into every frame and reading back
+     * which physical sticker each position shows, so the tables agree with
+     * Cube::orient by construction.
+     */
+    std::array<cross::OrientationTable, 24> buildTables(){
+	const Cube solved;
+	std::array<cross::OrientationTable, 24> tables;
+
+	for(int o = 0; o < 24; o++){
+	    Cube temp = solved;
+	    temp.orient(cross::ORIENTATIONS[o].first, cross::ORIENTATIONS[o].second);
+
+	    std::array<std::uint8_t, 24> physical;	// inverse of relabel
+	    for(int j = 0; j < 24; j++){
+		int s = solvedSticker(solved, colorAt(temp, j), colorAt(temp, j ^ 1));
+		physical[j] = static_cast<std::uint8_t>(s);
+		tables[o].relabel[s] = static_cast<std::uint8_t>(j);
+	    }
+	    tables[o].physical = physical;
+
+	    for(int j = 0; j < 24; j++){
+		int j1 = nextInCorner(j);
+		int s = solvedCornerSticker(solved, cornerColorAt(temp, j), cornerColorAt(temp, j1), cornerColorAt(temp, nextInCorner(j1)));
+		tables[o].cornerPhysical[j] = static_cast<std::uint8_t>(s);
+		tables[o].cornerRelabel[s] = static_cast<std::uint8_t>(j);
+	    }
+
+	    for(int f = 0; f < 6; f++){
+		char center = temp.getColorAtPosition(static_cast<Face>(f), 1, 1);
+		for(int g = 0; g < 6; g++){
+		    if(solved.getColorAtPosition(static_cast<Face>(g), 1, 1) == center){
+			tables[o].moveFace[MOVE_FACE[f]] = static_cast<std::uint8_t>(MOVE_FACE[g]);
+		    }
+		}
+	    }
+
+	    // DF, DR, DB, DL down stickers in the oriented frame
+	    const int crossSlots[4] = {16, 22, 20, 18};
+	    for(int k = 0; k < 4; k++){
+		tables[o].crossEdge[k] = physical[crossSlots[k]];
+	    }
+	}
+	return tables;
+    }
+}
+
+const std::array<cross::OrientationTable, 24>& cross::orientationTables(){
+    static const std::array<OrientationTable, 24> tables = buildTables();
+    return tables;
+}
+
+cross::EdgeLocations cross::orientEdges(const EdgeLocations& loc, const OrientationTable& t){
+    EdgeLocations res;
+    for(int p = 0; p < 12; p++){
+	int s = t.physical[2 * p];
+	res[p] = t.relabel[loc[s >> 1] ^ (s & 1)];
+    }
+    return res;
+}
+
+cross::CornerLocations cross::orientCorners(const CornerLocations& loc, const OrientationTable& t){
+    CornerLocations res;
+    for(int p = 0; p < 8; p++){
+	int s = t.cornerPhysical[3 * p];
+	int l = loc[s / 3];
+	res[p] = t.cornerRelabel[3 * (l / 3) + (l % 3 + s % 3) % 3];
+    }
+    return res;
+}
+
+cross::EdgeLocations cross::edgeLocations(const Cube& c){
+    int faceOf[256];
+    for(int i = 0; i < 256; i++) faceOf[i] = -1;
+    for(int f = 0; f < 6; f++){
+	faceOf[static_cast<unsigned char>(c.getColorAtPosition(static_cast<Face>(f), 1, 1))] = f;
+    }
+
+    EdgeLocations loc{};
+    for(int l = 0; l < 24; l += 2){
+	int a = faceOf[static_cast<unsigned char>(colorAt(c, l))];
+	int b = faceOf[static_cast<unsigned char>(colorAt(c, l + 1))];
+	bool found = false;
+	for(int p = 0; p < 12 && !found; p++){
+	    int pa = static_cast<int>(std::get<0>(EDGE_POSITIONS[2 * p]));
+	    int pb = static_cast<int>(std::get<0>(EDGE_POSITIONS[2 * p + 1]));
+	    if(a == pa && b == pb){
+		loc[p] = static_cast<std::uint8_t>(l);
+		found = true;
+	    } else if(a == pb && b == pa){
+		loc[p] = static_cast<std::uint8_t>(l + 1);
+		found = true;
+	    }
+	}
+	if(!found) std::cerr << "edge slot " << l / 2 << " does not hold a valid edge" << std::endl;
+    }
+    return loc;
+}
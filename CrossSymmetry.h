@@ -0,0 +1,76 @@
+#ifndef CROSS_SYMMETRY_H
+#define CROSS_SYMMETRY_H
+
+#include <array>
+#include <cstdint>
+#include "Cube.h"
+#include "Moves.h"
+
+namespace cross {
+
+    /*
+     * Edge state as the location (EDGE_POSITIONS index) of every edge piece's
+     * reference sticker, pieces numbered by their solved slot. The other
+     * sticker of piece p is always at loc[p] ^ 1.
+     */
+    using EdgeLocations = std::array<std::uint8_t, 12>;
+
+    /*
+     * Same idea for corners: CORNER_POSITIONS index of every corner piece's
+     * U/D sticker. Sticker t (clockwise) of piece p is at
+     * 3 * (loc[p] / 3) + (loc[p] + t) % 3.
+     */
+    using CornerLocations = std::array<std::uint8_t, 8>;
+
+    /*
+     * Re-orienting the cube never moves a sticker, it only renames positions,
+     * so for every (Down, Front) pair in ORIENTATIONS we keep:
+     *   relabel[l]   - EDGE_POSITIONS index that physical location l gets in that frame
+     *   crossEdge[k] - solved sticker (2 * piece + side) of the cross edge whose
+     *                  position getCrossLocations() reports in slot k
+     *   physical[j]  - inverse of relabel
+     * plus the same pair for corner stickers, and which physical face
+     * (moves::face order) each face letter turns in that frame.
+     */
+    struct OrientationTable {
+	std::array<std::uint8_t, 24> relabel;
+	std::array<std::uint8_t, 4> crossEdge;
+	std::array<std::uint8_t, 24> physical;
+	std::array<std::uint8_t, 24> cornerRelabel;
+	std::array<std::uint8_t, 24> cornerPhysical;
+	std::array<std::uint8_t, 6> moveFace;
+    };
+
+    const std::array<OrientationTable, 24>& orientationTables();
+
+    // reads the 24 edge stickers once
+    EdgeLocations edgeLocations(const Cube& c);
+
+    // same as orienting a copy of the cube and calling getCrossLocations()
+    inline std::array<int, 4> crossLocations(const EdgeLocations& loc, const OrientationTable& t) {
+	std::array<int, 4> res;
+	for(int k = 0; k < 4; k++){
+	    int s = t.crossEdge[k];
+	    res[k] = t.relabel[loc[s >> 1] ^ (s & 1)];
+	}
+	return res;
+    }
+
+    // the whole edge / corner state as seen from that frame
+    EdgeLocations orientEdges(const EdgeLocations& loc, const OrientationTable& t);
+    CornerLocations orientCorners(const CornerLocations& loc, const OrientationTable& t);
+
+    // a move named in that frame as a move of the unrotated cube, and back
+    inline int physicalMove(int move, const OrientationTable& t) {
+	return 3 * t.moveFace[moves::face(move)] + moves::turn(move);
+    }
+
+    inline int frameMove(int move, const OrientationTable& t) {
+	for(int f = 0; f < 6; f++){
+	    if(t.moveFace[f] == moves::face(move)) return 3 * f + moves::turn(move);
+	}
+	return move;
+    }
+}
+
+#endif
@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "CrossTableFile.h"
+#include "CrossDistance.h"
+
+namespace {
+    constexpr char MAGIC[8] = {'X', 'C', 'T', 'A', 'B', 'L', 'E', '\0'};
+
+    static_assert(sizeof(cross::TableFileHeader) == 104, "header layout changed, bump TABLE_FILE_VERSION");
+    static_assert(sizeof(cross::TableFileEntry) == 8, "entry layout changed, bump TABLE_FILE_VERSION");
+
+    std::uint64_t fnv1a(const unsigned char* p, std::size_t n, std::uint64_t h = 14695981039346656037ULL){
+	for(std::size_t i = 0; i < n; i++){
+	    h ^= p[i];
+	    h *= 1099511628211ULL;
+	}
+	return h;
+    }
+
+    std::uint64_t headerChecksum(const cross::TableFileHeader& h){
+	return fnv1a(reinterpret_cast<const unsigned char*>(&h), offsetof(cross::TableFileHeader, headerChecksum));
+    }
+}
+
+std::unique_ptr<cross::MappedCrossTable> cross::MappedCrossTable::open(const std::string& path, std::string& error, bool verifyData){
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if(fd < 0){
+	error = "cannot open " + path;
+	return nullptr;
+    }
+    struct stat st;
+    if(fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(TableFileHeader)){
+	::close(fd);
+	error = path + " is too small to be a cross table";
+	return nullptr;
+    }
+    std::size_t size = static_cast<std::size_t>(st.st_size);
+    void* p = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if(p == MAP_FAILED){
+	error = "cannot map " + path;
+	return nullptr;
+    }
+    // lookups jump all over the index, read-ahead would just pull in pages nobody asked for
+    madvise(p, size, MADV_RANDOM);
+
+    std::unique_ptr<MappedCrossTable> t(new MappedCrossTable());
+    t->data_ = static_cast<const unsigned char*>(p);
+    t->size_ = size;
+    t->header_ = reinterpret_cast<const TableFileHeader*>(t->data_);
+
+    const TableFileHeader& h = *t->header_;
+    if(std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0){
+	error = path + " is not a cross table file";
+	return nullptr;
+    }
+    if(h.version != TABLE_FILE_VERSION){
+	error = path + " has table version " + std::to_string(h.version) + ", expected " + std::to_string(TABLE_FILE_VERSION);
+	return nullptr;
+    }
+    if(headerChecksum(h) != h.headerChecksum){
+	error = path + " has a corrupt header";
+	return nullptr;
+    }
+    if(h.base != BASE || h.states != STATES){
+	error = path + " was built for another index layout";
+	return nullptr;
+    }
+    std::size_t expected = sizeof(TableFileHeader) + sizeof(std::int32_t) * h.states + sizeof(TableFileEntry) * h.entryCount + h.blobSize;
+    if(size != expected){
+	error = path + " is truncated or has trailing data";
+	return nullptr;
+    }
+
+    t->index_ = reinterpret_cast<const std::int32_t*>(t->data_ + sizeof(TableFileHeader));
+    t->entries_ = reinterpret_cast<const TableFileEntry*>(t->index_ + h.states);
+    t->blob_ = reinterpret_cast<const char*>(t->entries_ + h.entryCount);
+
+    if(verifyData && !t->verify()){
+	error = path + " failed its checksum";
+	return nullptr;
+    }
+    return t;
+}
+
+cross::MappedCrossTable::~MappedCrossTable(){
+    if(data_) munmap(const_cast<unsigned char*>(data_), size_);
+}
+
+bool cross::MappedCrossTable::verify() const noexcept {
+    std::size_t off = sizeof(TableFileHeader);
+    return fnv1a(data_ + off, size_ - off) == header_->dataChecksum;
+}
+
+std::string_view cross::MappedCrossTable::lookup(std::size_t idx) const noexcept {
+    std::int32_t entry = index_[idx];
+    if(entry < 0 || static_cast<std::uint32_t>(entry) >= header_->entryCount) return {};
+    const TableFileEntry& e = entries_[entry];
+    if(e.offset + static_cast<std::uint64_t>(e.length) > header_->blobSize) return {};
+    return std::string_view{blob_ + e.offset, e.length};
+}
+
+std::string cross::MappedCrossTable::description() const {
+    return std::string(header_->description, strnlen(header_->description, sizeof(header_->description)));
+}
+
+bool cross::writeTableFile(const std::string& path, const std::vector<int>& index, const std::vector<std::pair<std::size_t, std::size_t>>& entries,
+			   const std::string& blob, const std::string& description){
+    std::vector<unsigned char> data(sizeof(std::int32_t) * index.size() + sizeof(TableFileEntry) * entries.size() + blob.size());
+    unsigned char* p = data.data();
+    for(int i : index){
+	std::int32_t v = i;
+	std::memcpy(p, &v, sizeof(v));
+	p += sizeof(v);
+    }
+    for(const auto& e : entries){
+	TableFileEntry fe{static_cast<std::uint32_t>(e.first), static_cast<std::uint16_t>(e.second), 0};
+	std::memcpy(p, &fe, sizeof(fe));
+	p += sizeof(fe);
+    }
+    std::memcpy(p, blob.data(), blob.size());
+
+    TableFileHeader h{};
+    std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+    h.version = TABLE_FILE_VERSION;
+    h.base = static_cast<std::uint32_t>(BASE);
+    h.states = static_cast<std::uint32_t>(index.size());
+    h.entryCount = static_cast<std::uint32_t>(entries.size());
+    h.blobSize = blob.size();
+    h.dataChecksum = fnv1a(data.data(), data.size());
+    std::memcpy(h.description, description.data(), std::min(description.size(), sizeof(h.description) - 1));
+    h.headerChecksum = headerChecksum(h);
+
+    // write next to the target and rename, so a running solver never maps a half-written file
+    std::string tmp = path + ".tmp";
+    {
+	std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+	if(!out) return false;
+	out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+	out.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+	if(!out) return false;
+    }
+    return std::rename(tmp.c_str(), path.c_str()) == 0;
+}
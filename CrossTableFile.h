@@ -0,0 +1,79 @@
+#ifndef CROSS_TABLE_FILE_H
+#define CROSS_TABLE_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/*
+ * The cross table as a binary file, same data as CrossTable.generated.hpp:
+ *
+ *   header (magic "XCTABLE", version, index layout, sizes, checksums)
+ *   int32  index[states]      entry per base-24 index, -1 when solved / not a cross
+ *   Entry  entries[entryCount] offset + length into the move text
+ *   char   blob[blobSize]      move text
+ *
+ * Native byte order (the file is built next to the binary by cross-table-gen).
+ * It's mmap'd read-only, so concurrent solvers share the pages and only the
+ * ones a lookup touches are read in.
+ */
+namespace cross {
+
+    constexpr std::uint32_t TABLE_FILE_VERSION = 1;
+
+    struct TableFileHeader {
+	char magic[8];
+	std::uint32_t version;
+	std::uint32_t base;
+	std::uint32_t states;
+	std::uint32_t entryCount;
+	std::uint64_t blobSize;
+	std::uint64_t dataChecksum;	//FNV-1a over everything after the header
+	char description[56];
+	std::uint64_t headerChecksum;	//FNV-1a over the header up to here
+    };
+
+    struct TableFileEntry {
+	std::uint32_t offset;
+	std::uint16_t length;
+	std::uint16_t reserved;
+    };
+
+    class MappedCrossTable {
+    private:
+	const unsigned char* data_ = nullptr;
+	std::size_t size_ = 0;
+	const TableFileHeader* header_ = nullptr;
+	const std::int32_t* index_ = nullptr;
+	const TableFileEntry* entries_ = nullptr;
+	const char* blob_ = nullptr;
+
+	MappedCrossTable() = default;
+
+    public:
+	/*
+	 * Maps and checks the header and sizes. The data checksum means reading
+	 * the whole file, so it's only checked with verifyData (or verify()).
+	 * Returns nullptr and fills `error` on any problem.
+	 */
+	static std::unique_ptr<MappedCrossTable> open(const std::string& path, std::string& error, bool verifyData = false);
+	~MappedCrossTable();
+	MappedCrossTable(const MappedCrossTable&) = delete;
+	MappedCrossTable& operator=(const MappedCrossTable&) = delete;
+
+	bool verify() const noexcept;
+	std::string_view lookup(std::size_t idx) const noexcept;
+	std::string description() const;
+	std::size_t bytes() const noexcept { return size_; }
+    };
+
+    // writes the file cross-table-gen produces; entries are (offset, length) into blob
+    bool writeTableFile(const std::string& path, const std::vector<int>& index, const std::vector<std::pair<std::size_t, std::size_t>>& entries,
+			const std::string& blob, const std::string& description);
+}
+
+#endif
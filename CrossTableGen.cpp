@@ -0,0 +1,237 @@
+/*
+ * Builds include/CrossTable.generated.hpp: the optimal cross for every
+ * base-24 index slot, found by breadth-first search from the solved cross.
+ * With --compact it writes include/CrossTableCompact.generated.hpp instead,
+ * just the distances packed two per byte plus the move order to descend in.
+ * With --binary the full table goes to a versioned, checksummed file (see
+ * CrossTableFile.h) that the solver maps at runtime instead.
+ *
+ *   cross-table-gen [--out FILE] [--compact | --binary] [--metric htm|qtm] [--faces RLUDFB] [--threads N]
+ *
+ * Output is deterministic for any thread count.
+ */
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "CrossDistance.h"
+#include "CrossTableFile.h"
+#include "DistanceTable.h"
+#include "Moves.h"
+
+namespace {
+
+    void usage(const char* prog){
+	std::cerr << "usage: " << prog << " [--out FILE] [--compact | --binary] [--metric htm|qtm] [--faces RLUDFB] [--threads N]" << std::endl;
+    }
+
+    // nibble 0xF is reserved for states the move set can't solve (or that aren't a cross at all)
+    constexpr int kCompactUnreached = 0xF;
+
+    /*
+     * Move text for a solution. Under QTM the search only has quarter turns,
+     * so two equal quarter turns in a row are written as one half turn.
+     */
+    std::string moveText(const std::vector<int>& sol){
+	std::string res;
+	for(std::size_t i = 0; i < sol.size(); i++){
+	    int m = sol[i];
+	    if(moves::turn(m) != 2 && i + 1 < sol.size() && sol[i + 1] == m){
+		m = 3 * moves::face(m) + 2;
+		i++;
+	    }
+	    if(!res.empty()) res += ' ';
+	    res += moves::NAMES[m];
+	}
+	return res;
+    }
+
+    void writeHeader(std::ostream& out, const std::vector<int>& index, const std::vector<std::pair<std::size_t, std::size_t>>& entries,
+		     const std::string& blob, const std::string& description){
+	out << "// Generated by cross-table-gen (" << description << "). Do not edit.\n";
+	out << "#pragma once\n\n#include <cstddef>\n#include <cstdint>\n\n";
+	out << "namespace cross_table {\n\n";
+	out << "inline constexpr std::size_t kBase = " << cross::BASE << ";\n\n";
+	out << "struct Entry {\n    std::uint32_t str_offset;\n    std::uint16_t str_len;\n};\n\n";
+
+	out << "// entry into kEntries per base-24 index, -1 when solved or not a real cross\n";
+	out << "inline constexpr int kIndex[" << index.size() << "] = {\n";
+	for(std::size_t i = 0; i < index.size(); i++){
+	    out << index[i] << (i + 1 < index.size() ? "," : "") << ((i % 24 == 23) ? "\n" : "");
+	}
+	out << "};\n\n";
+
+	out << "inline constexpr Entry kEntries[" << entries.size() << "] = {\n";
+	for(std::size_t i = 0; i < entries.size(); i++){
+	    out << "{" << entries[i].first << "," << entries[i].second << "}" << (i + 1 < entries.size() ? "," : "") << ((i % 12 == 11) ? "\n" : "");
+	}
+	out << "};\n\n";
+
+	out << "inline constexpr char kMovesBlob[] =\n";
+	constexpr std::size_t kLine = 120;
+	for(std::size_t i = 0; i < blob.size(); i += kLine){
+	    out << "\"" << blob.substr(i, kLine) << "\"\n";
+	}
+	if(blob.empty()) out << "\"\"\n";
+	out << ";\n\n}\n";
+    }
+
+    void writeCompactHeader(std::ostream& out, const std::vector<std::uint8_t>& dist, const std::vector<int>& moveSet, const std::string& description){
+	out << "// Generated by cross-table-gen --compact (" << description << "). Do not edit.\n";
+	out << "#pragma once\n\n#include <cstddef>\n#include <cstdint>\n\n";
+	out << "namespace cross_table_compact {\n\n";
+	out << "inline constexpr std::size_t kBase = " << cross::BASE << ";\n\n";
+
+	out << "// descend tries the moves in this order, same as the full table\n";
+	out << "inline constexpr int kMoveCount = " << moveSet.size() << ";\n";
+	out << "inline constexpr std::uint8_t kMoves[" << moveSet.size() << "] = {";
+	for(std::size_t i = 0; i < moveSet.size(); i++) out << moveSet[i] << (i + 1 < moveSet.size() ? "," : "");
+	out << "};\n\n";
+
+	std::size_t bytes = (dist.size() + 1) / 2;
+	out << "// distance of index 2i in the low nibble of byte i, 2i+1 in the high one, 0xF when unsolvable\n";
+	out << "inline constexpr std::uint8_t kDist[" << bytes << "] = {\n";
+	for(std::size_t i = 0; i < bytes; i++){
+	    int lo = dist[2 * i] == dist::UNREACHED ? kCompactUnreached : dist[2 * i];
+	    int hi = (2 * i + 1 >= dist.size() || dist[2 * i + 1] == dist::UNREACHED) ? kCompactUnreached : dist[2 * i + 1];
+	    out << (lo | (hi << 4)) << (i + 1 < bytes ? "," : "") << ((i % 32 == 31) ? "\n" : "");
+	}
+	out << "};\n\n}\n";
+    }
+
+    int writeOutput(const std::string& outPath, const std::function<void(std::ostream&)>& write){
+	if(outPath.empty()){
+	    write(std::cout);
+	    return 0;
+	}
+	std::ofstream out(outPath);
+	if(!out){
+	    std::cerr << "cannot open " << outPath << std::endl;
+	    return 1;
+	}
+	write(out);
+	return 0;
+    }
+}
+
+int main(int argc, char** argv){
+    std::string outPath;
+    std::string metric = "htm";
+    std::string faces = "RLUDFB";
+    bool compact = false;
+    bool binary = false;
+    unsigned threads = std::thread::hardware_concurrency();
+
+    for(int i = 1; i < argc; i++){
+	std::string_view arg = argv[i];
+	if(arg == "--out" && i + 1 < argc){
+	    outPath = argv[++i];
+	} else if(arg == "--compact"){
+	    compact = true;
+	} else if(arg == "--binary"){
+	    binary = true;
+	} else if(arg == "--metric" && i + 1 < argc){
+	    metric = argv[++i];
+	} else if(arg == "--faces" && i + 1 < argc){
+	    faces = argv[++i];
+	} else if(arg == "--threads" && i + 1 < argc){
+	    int n = std::atoi(argv[++i]);
+	    if(n <= 0){
+		usage(argv[0]);
+		return 1;
+	    }
+	    threads = static_cast<unsigned>(n);
+	} else {
+	    usage(argv[0]);
+	    return 1;
+	}
+    }
+    if((metric != "htm" && metric != "qtm") || (binary && (compact || outPath.empty()))){
+	usage(argv[0]);
+	return 1;
+    }
+
+    // move set: every allowed face, half turns only under HTM
+    std::vector<int> moveSet;
+    const std::string_view faceLetters = "RLUDFB";
+    for(int m = 0; m < moves::COUNT; m++){
+	if(faces.find(faceLetters[moves::face(m)]) == std::string::npos) continue;
+	if(metric == "qtm" && moves::turn(m) == 2) continue;
+	moveSet.push_back(m);
+    }
+    if(moveSet.empty()){
+	std::cerr << "no moves left in the move set" << std::endl;
+	return 1;
+    }
+
+    std::vector<std::uint8_t> dist = cross::buildDistances(moveSet, threads);
+    std::string description = "metric " + metric + ", faces " + faces;
+
+    if(compact){
+	int maxDepth = 0;
+	for(std::uint8_t d : dist){
+	    if(d != dist::UNREACHED && d > maxDepth) maxDepth = d;
+	}
+	if(maxDepth >= kCompactUnreached){
+	    std::cerr << "max depth " << maxDepth << " doesn't fit in 4 bits, use the full table" << std::endl;
+	    return 1;
+	}
+	if(writeOutput(outPath, [&](std::ostream& out){ writeCompactHeader(out, dist, moveSet, description); }) != 0) return 1;
+	std::cerr << "compact cross table: " << (dist.size() + 1) / 2 << " bytes, max depth " << maxDepth << " (" << description << ")" << std::endl;
+	return 0;
+    }
+
+    // identical solutions share one entry and one run of blob text
+    std::vector<int> index(cross::STATES, -1);
+    std::vector<std::pair<std::size_t, std::size_t>> entries;
+    std::unordered_map<std::string, int> seen;
+    std::string blob;
+    std::size_t unsolvable = 0;
+    int maxDepth = 0;
+
+    for(std::size_t idx = 0; idx < cross::STATES; idx++){
+	std::array<int, 4> pos = cross::unpackIndex(idx);
+	bool real = true;
+	for(int a = 0; a < 4; a++){
+	    for(int b = a + 1; b < 4; b++){
+		if(pos[a] / 2 == pos[b] / 2) real = false;
+	    }
+	}
+	if(!real) continue;
+	if(dist[idx] == dist::UNREACHED){
+	    ++unsolvable;
+	    continue;
+	}
+	if(dist[idx] == 0) continue;
+	if(dist[idx] > maxDepth) maxDepth = dist[idx];
+
+	std::string text = moveText(cross::descend(dist, idx, moveSet));
+	auto it = seen.find(text);
+	if(it == seen.end()){
+	    it = seen.emplace(text, static_cast<int>(entries.size())).first;
+	    entries.push_back({blob.size(), text.size()});
+	    blob += text;
+	}
+	index[idx] = it->second;
+    }
+
+    if(binary){
+	if(!cross::writeTableFile(outPath, index, entries, blob, description)){
+	    std::cerr << "cannot write " << outPath << std::endl;
+	    return 1;
+	}
+    } else if(writeOutput(outPath, [&](std::ostream& out){ writeHeader(out, index, entries, blob, description); }) != 0){
+	return 1;
+    }
+
+    std::cerr << "cross table: " << entries.size() << " solutions, max depth " << maxDepth << " (" << description << ")";
+    if(unsolvable > 0) std::cerr << ", " << unsolvable << " states unreachable";
+    std::cerr << std::endl;
+    return 0;
+}
@@ -1,4 +1,5 @@
 #include "Cube.h"
+#include <algorithm>
 #include <array>
 
 Cube::Cube() {
@@ -264,42 +265,7 @@ void Cube::orient(Face new_down, Face new_front){
 
 /* Global/Friend Functions*/
 std::ostream& operator<<(std::ostream& out, const Cube& c){
-
-    //print topside
-    out << "         " << "_______" << std::endl;
-    for(int i = 0; i < 3; i++){
-	out << "         ";
-	for(int j = 0; j < 3; j++){
-	    out << "|" << c.getColorAtPosition(Face::UP, i, j);
-	}
-	out << "|" << std::endl;
-    }
-
-    //print middle strip
-    out << "----------------------------------" << std::endl;
-    for(int i = 0; i < 3; i++){
-	for(Face f : {Face::LEFT, Face::FRONT, Face::RIGHT, Face::BACK}){
-	    for(int k = 0; k < 3; k++){
-		out << "|" << c.getColorAtPosition(f, i, k);
-	    }
-	    if(f == Face::BACK){
-		continue;
-	    }
-	    out << "|  ";
-	}
-	out << "|" << std::endl;
-    }
-    out << "----------------------------------" << std::endl;
-
-    //print bottom side
-    for(int i = 0; i < 3; i++){
-	out << "         ";
-	for(int j = 0; j < 3; j++){
-	    out << "|" << c.getColorAtPosition(Face::DOWN, i, j);
-	}
-	out << "|" << std::endl;
-    }
-    out << "         " << "-------" << std::endl;
-
-    return out;
+    std::string net;
+    appendNet(net, c);
+    return out << net;
 }
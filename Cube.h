@@ -1,7 +1,9 @@
 #ifndef CUBE_H
 #define CUBE_H
 
+#include <array>
 #include <iostream>
+#include <string>
 #include <unordered_map>
 
 enum class Face {
@@ -58,6 +60,50 @@ public:
     void rotate_face_counter_clockwise(Face face);
 };
 
+// the unfolded net, one line per row (no flushing), for anything with getColorAtPosition
+template <typename CubeLike>
+void appendNet(std::string& out, const CubeLike& c){
+
+    //print topside
+    out += "         _______\n";
+    for(int i = 0; i < 3; i++){
+	out += "         ";
+	for(int j = 0; j < 3; j++){
+	    out += '|';
+	    out += c.getColorAtPosition(Face::UP, i, j);
+	}
+	out += "|\n";
+    }
+
+    //print middle strip
+    out += "----------------------------------\n";
+    for(int i = 0; i < 3; i++){
+	for(Face f : {Face::LEFT, Face::FRONT, Face::RIGHT, Face::BACK}){
+	    for(int k = 0; k < 3; k++){
+		out += '|';
+		out += c.getColorAtPosition(f, i, k);
+	    }
+	    if(f == Face::BACK){
+		continue;
+	    }
+	    out += "|  ";
+	}
+	out += "|\n";
+    }
+    out += "----------------------------------\n";
+
+    //print bottom side
+    for(int i = 0; i < 3; i++){
+	out += "         ";
+	for(int j = 0; j < 3; j++){
+	    out += '|';
+	    out += c.getColorAtPosition(Face::DOWN, i, j);
+	}
+	out += "|\n";
+    }
+    out += "         -------\n";
+}
+
 std::ostream& operator<<(std::ostream& out, const Cube& c);
 #endif
 
@@ -1,5 +1,6 @@
 #include "CubeManipulator.h"
 #include "Cube.h"
+#include "Moves.h"
 #include <array>
 
 CubeManipulator::CubeManipulator(Cube& c) : cube(c) {}
@@ -280,51 +281,40 @@ void CubeManipulator::b_two(){
     cube.rotate_face_180(Face::BACK);
 }
 
-void CubeManipulator::applyMove(const std::string& move){
-    if (move == "R"){
-	r_norm();
-    } else if (move == "R'"){
-	r_prime();
-    } else if (move == "R2"){
-	r_two();
-    } else if (move == "L"){
-	l_norm();
-    } else if (move == "L'"){
-	l_prime();
-    } else if (move == "L2"){
-	l_two();
-    } else if (move == "U"){
-	u_norm();
-    } else if (move == "U'"){
-	u_prime();
-    } else if (move == "U2"){
-	u_two();
-    } else if (move == "D"){
-	d_norm();
-    } else if (move == "D'"){
-	d_prime();
-    } else if (move == "D2"){
-	d_two();
-    } else if (move == "F"){
-	f_norm();
-    } else if (move == "F'"){
-	f_prime();
-    } else if (move == "F2"){
-	f_two();
-    } else if (move == "B"){
-	b_norm();
-    } else if (move == "B'"){
-	b_prime();
-    } else if (move == "B2"){
-	b_two();
-    } else {
-	std::cerr << "UNKNOWN MOVE: " << move << std::endl;
+namespace {
+    // indexed by moves::Move code
+    using Turn = void (CubeManipulator::*)();
+    constexpr Turn TURNS[moves::COUNT] = {
+	&CubeManipulator::r_norm, &CubeManipulator::r_prime, &CubeManipulator::r_two,
+	&CubeManipulator::l_norm, &CubeManipulator::l_prime, &CubeManipulator::l_two,
+	&CubeManipulator::u_norm, &CubeManipulator::u_prime, &CubeManipulator::u_two,
+	&CubeManipulator::d_norm, &CubeManipulator::d_prime, &CubeManipulator::d_two,
+	&CubeManipulator::f_norm, &CubeManipulator::f_prime, &CubeManipulator::f_two,
+	&CubeManipulator::b_norm, &CubeManipulator::b_prime, &CubeManipulator::b_two
+    };
+}
+
+void CubeManipulator::applyMove(int move){
+    (this->*TURNS[move])();
+}
+
+void CubeManipulator::applyMoves(const std::uint8_t* moves, std::size_t n){
+    for(std::size_t i = 0; i < n; i++){
+	(this->*TURNS[moves[i]])();
     }
 }
 
-void CubeManipulator::applyManyMoves(const std::vector<std::string>& moves){
+bool CubeManipulator::applyMove(const std::string& move){
+    int m = moves::fromName(move);
+    if(m < 0) return false;
+    applyMove(m);
+    return true;
+}
+
+bool CubeManipulator::applyManyMoves(const std::vector<std::string>& moves){
+    bool ok = true;
     for(const std::string& move : moves){
-	applyMove(move);
+	ok = applyMove(move) && ok;
     }
+    return ok;
 }
-
@@ -1,6 +1,10 @@
 #ifndef CUBE_MANIPULATOR_H
 #define CUBE_MANIPULATOR_H
 
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
 #include "Cube.h"
 
 class CubeManipulator {
@@ -13,8 +17,10 @@ public:
     CubeManipulator(Cube& c);
     
     //Cube Manipulators
-    void applyMove(const std::string& move); 
-    void applyManyMoves(const std::vector<std::string>& moves);
+    void applyMove(int move);	//moves::Move code
+    void applyMoves(const std::uint8_t* moves, std::size_t n);
+    bool applyMove(const std::string& move);	//false (and nothing done) for an unknown move
+    bool applyManyMoves(const std::vector<std::string>& moves);
     
     void r_norm();
     void r_prime();
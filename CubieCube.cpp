@@ -0,0 +1,190 @@
+#include "CubieCube.h"
+#include "CrossConstants.hpp"
+#include "Moves.h"
+
+namespace {
+
+    // the 18 face turns in Moves.h order, derived from CubeManipulator on a solved cube
+    constexpr std::array<CubieCube, moves::COUNT> MOVES{{
+	// R
+	{{{4, 1, 2, 0, 7, 5, 6, 3}}, {{2, 0, 0, 1, 1, 0, 0, 2}},
+	 {{0, 1, 2, 4, 11, 5, 6, 3, 8, 9, 10, 7}}, {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}}},
+	// R'
+	{{{3, 1, 2, 7, 0, 5, 6, 4}}, {{2, 0, 0, 1, 1, 0, 0, 2}},
+	 {{0, 1, 2, 7, 3, 5, 6, 11, 8, 9, 10, 4}}, {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}}},
+	// R2
+	{{{7, 1, 2, 4, 3, 5, 6, 0}}, {{0, 0, 0, 0, 0, 0, 0, 0}},
+	 {{0, 1, 2, 11, 7, 5, 6, 4, 8, 9, 10, 3}}, {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}}},
+	// L
+	{{{0, 2, 6, 3, 4, 1, 5, 7}}, {{0, 1, 2, 0, 0, 2, 1, 0}},
+	 {{0, 6, 2, 3, 4, 1, 9, 7, 8, 5, 10, 11}}, {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}}},
+	// L'
+	{{{0, 5, 1, 3, 4, 6, 2, 7}}, {{0, 1, 2, 0, 0, 2, 1, 0}},
+	 {{0, 5, 2, 3, 4, 9, 1, 7, 8, 6, 10, 11}}, {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}}},
+	// L2
+	{{{0, 6, 5, 3, 4, 2, 1, 7}}, {{0, 0, 0, 0, 0, 0, 0, 0}},
+	 {{0, 9, 2, 3, 4, 6, 5, 7, 8, 1, 10, 11}}, {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}}},
+	// U
+	{{{3, 0, 1, 2, 4, 5, 6, 7}}, {{0, 0, 0, 0, 0, 0, 0, 0}},
+	 {{3, 0, 1, 2, 4, 5, 6, 7, 8, 9, 10, 11}}, {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}}},
+	// U'
+	{{{1, 2, 3, 0, 4, 5, 6, 7}}, {{0, 0, 0, 0, 0, 0, 0, 0}},
+	 {{1, 2, 3, 0, 4, 5, 6, 7, 8, 9, 10, 11}}, {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}}},
+	// U2
+	{{{2, 3, 0, 1, 4, 5, 6, 7}}, {{0, 0, 0, 0, 0, 0, 0, 0}},
+	 {{2, 3, 0, 1, 4, 5, 6, 7, 8, 9, 10, 11}}, {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}}},
+	// D
+	{{{0, 1, 2, 3, 5, 6, 7, 4}}, {{0, 0, 0, 0, 0, 0, 0, 0}},
+	 {{0, 1, 2, 3, 4, 5, 6, 7, 9, 10, 11, 8}}, {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}}},
+	// D'
+	{{{0, 1, 2, 3, 7, 4, 5, 6}}, {{0, 0, 0, 0, 0, 0, 0, 0}},
+	 {{0, 1, 2, 3, 4, 5, 6, 7, 11, 8, 9, 10}}, {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}}},
+	// D2
+	{{{0, 1, 2, 3, 6, 7, 4, 5}}, {{0, 0, 0, 0, 0, 0, 0, 0}},
+	 {{0, 1, 2, 3, 4, 5, 6, 7, 10, 11, 8, 9}}, {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}}},
+	// F
+	{{{1, 5, 2, 3, 0, 4, 6, 7}}, {{1, 2, 0, 0, 2, 1, 0, 0}},
+	 {{5, 1, 2, 3, 0, 8, 6, 7, 4, 9, 10, 11}}, {{1, 0, 0, 0, 1, 1, 0, 0, 1, 0, 0, 0}}},
+	// F'
+	{{{4, 0, 2, 3, 5, 1, 6, 7}}, {{1, 2, 0, 0, 2, 1, 0, 0}},
+	 {{4, 1, 2, 3, 8, 0, 6, 7, 5, 9, 10, 11}}, {{1, 0, 0, 0, 1, 1, 0, 0, 1, 0, 0, 0}}},
+	// F2
+	{{{5, 4, 2, 3, 1, 0, 6, 7}}, {{0, 0, 0, 0, 0, 0, 0, 0}},
+	 {{8, 1, 2, 3, 5, 4, 6, 7, 0, 9, 10, 11}}, {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}}},
+	// B
+	{{{0, 1, 3, 7, 4, 5, 2, 6}}, {{0, 0, 1, 2, 0, 0, 2, 1}},
+	 {{0, 1, 7, 3, 4, 5, 2, 10, 8, 9, 6, 11}}, {{0, 0, 1, 0, 0, 0, 1, 1, 0, 0, 1, 0}}},
+	// B'
+	{{{0, 1, 6, 2, 4, 5, 7, 3}}, {{0, 0, 1, 2, 0, 0, 2, 1}},
+	 {{0, 1, 6, 3, 4, 5, 10, 2, 8, 9, 7, 11}}, {{0, 0, 1, 0, 0, 0, 1, 1, 0, 0, 1, 0}}},
+	// B2
+	{{{0, 1, 7, 6, 4, 5, 3, 2}}, {{0, 0, 0, 0, 0, 0, 0, 0}},
+	 {{0, 1, 10, 3, 4, 5, 7, 6, 8, 9, 2, 11}}, {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}}}
+    }};
+
+    constexpr std::uint8_t MOD3[6] = {0, 1, 2, 0, 1, 2};
+
+    // colour every face has on a freshly constructed Cube
+    constexpr char SOLVED_COLORS[6] = {'W', 'O', 'G', 'R', 'B', 'Y'};
+
+    char colorAt(const Cube& c, const std::tuple<Face, int, int>& p){
+	return c.getColorAtPosition(std::get<0>(p), std::get<1>(p), std::get<2>(p));
+    }
+}
+
+const CubieCube& CubieCube::move(int m){
+    return MOVES[m];
+}
+
+void CubieCube::multiply(const CubieCube& b){
+    CubieCube a = *this;
+    for(int i = 0; i < 8; i++){
+	cp[i] = a.cp[b.cp[i]];
+	co[i] = MOD3[a.co[b.cp[i]] + b.co[i]];
+    }
+    for(int i = 0; i < 12; i++){
+	ep[i] = a.ep[b.ep[i]];
+	eo[i] = a.eo[b.ep[i]] ^ b.eo[i];
+    }
+}
+
+void CubieCube::applyMove(int move){
+    multiply(MOVES[move]);
+}
+
+void CubieCube::applyMoves(const std::uint8_t* moves, std::size_t n){
+    for(std::size_t i = 0; i < n; i++){
+	multiply(MOVES[moves[i]]);
+    }
+}
+
+std::array<std::uint8_t, 12> CubieCube::edgeLocations() const {
+    std::array<std::uint8_t, 12> loc;
+    for(int s = 0; s < 12; s++){
+	loc[ep[s]] = static_cast<std::uint8_t>(2 * s + eo[s]);
+    }
+    return loc;
+}
+
+std::array<std::uint8_t, 8> CubieCube::cornerLocations() const {
+    std::array<std::uint8_t, 8> loc;
+    for(int s = 0; s < 8; s++){
+	loc[cp[s]] = static_cast<std::uint8_t>(3 * s + co[s]);
+    }
+    return loc;
+}
+
+bool CubieCube::operator==(const CubieCube& o) const {
+    return cp == o.cp && co == o.co && ep == o.ep && eo == o.eo;
+}
+
+std::optional<CubieCube> CubieCube::fromCube(const Cube& c){
+    // map colours back to the face whose center carries them
+    int faceOf[256];
+    for(int i = 0; i < 256; i++) faceOf[i] = -1;
+    for(int f = 0; f < 6; f++){
+	faceOf[static_cast<unsigned char>(c.getColorAtPosition(static_cast<Face>(f), 1, 1))] = f;
+    }
+    auto face = [&](char color){ return faceOf[static_cast<unsigned char>(color)]; };
+    auto solvedFace = [](const std::tuple<Face, int, int>& p){ return static_cast<int>(std::get<0>(p)); };
+
+    CubieCube res;
+    for(int s = 0; s < 8; s++){
+	int here[3];
+	for(int k = 0; k < 3; k++) here[k] = face(colorAt(c, cross::CORNER_POSITIONS[3 * s + k]));
+	bool found = false;
+	for(int p = 0; p < 8 && !found; p++){
+	    for(int t = 0; t < 3 && !found; t++){
+		bool match = true;
+		for(int k = 0; k < 3; k++){
+		    if(here[(t + k) % 3] != solvedFace(cross::CORNER_POSITIONS[3 * p + k])) match = false;
+		}
+		if(match){
+		    res.cp[s] = static_cast<std::uint8_t>(p);
+		    res.co[s] = static_cast<std::uint8_t>(t);
+		    found = true;
+		}
+	    }
+	}
+	if(!found) return std::nullopt;
+    }
+
+    for(int s = 0; s < 12; s++){
+	int a = face(colorAt(c, cross::EDGE_POSITIONS[2 * s]));
+	int b = face(colorAt(c, cross::EDGE_POSITIONS[2 * s + 1]));
+	bool found = false;
+	for(int p = 0; p < 12 && !found; p++){
+	    int pa = solvedFace(cross::EDGE_POSITIONS[2 * p]);
+	    int pb = solvedFace(cross::EDGE_POSITIONS[2 * p + 1]);
+	    if(a == pa && b == pb){
+		res.ep[s] = static_cast<std::uint8_t>(p);
+		res.eo[s] = 0;
+		found = true;
+	    } else if(a == pb && b == pa){
+		res.ep[s] = static_cast<std::uint8_t>(p);
+		res.eo[s] = 1;
+		found = true;
+	    }
+	}
+	if(!found) return std::nullopt;
+    }
+    return res;
+}
+
+Cube CubieCube::toCube() const {
+    Cube c;
+    auto paint = [&](const std::tuple<Face, int, int>& at, const std::tuple<Face, int, int>& from){
+	c.setColorAtPosition(std::get<0>(at), std::get<1>(at), std::get<2>(at), SOLVED_COLORS[static_cast<int>(std::get<0>(from))]);
+    };
+    for(int s = 0; s < 8; s++){
+	for(int k = 0; k < 3; k++){
+	    paint(cross::CORNER_POSITIONS[3 * s + (co[s] + k) % 3], cross::CORNER_POSITIONS[3 * cp[s] + k]);
+	}
+    }
+    for(int s = 0; s < 12; s++){
+	for(int k = 0; k < 2; k++){
+	    paint(cross::EDGE_POSITIONS[2 * s + (eo[s] ^ k)], cross::EDGE_POSITIONS[2 * ep[s] + k]);
+	}
+    }
+    return c;
+}
@@ -0,0 +1,45 @@
+#ifndef CUBIE_CUBE_H
+#define CUBIE_CUBE_H
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include "Cube.h"
+
+/*
+ * Piece-level cube state: which piece sits in each slot and how it is
+ * twisted/flipped. Corner slots follow cross::CORNER_POSITIONS and edge slots
+ * follow cross::EDGE_POSITIONS (slot k owns stickers 2k and 2k + 1).
+ *
+ * co[s] is which sticker of slot s (0..2, clockwise from the U/D one) holds
+ * the piece's U/D colour, eo[s] is 1 when the piece's reference colour sits on
+ * the odd sticker of the slot. Moves are compositions with fixed 20-piece
+ * tables, no facelets involved.
+ */
+struct CubieCube {
+    std::array<std::uint8_t, 8> cp{{0, 1, 2, 3, 4, 5, 6, 7}};
+    std::array<std::uint8_t, 8> co{};
+    std::array<std::uint8_t, 12> ep{{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11}};
+    std::array<std::uint8_t, 12> eo{};
+
+    //Conversion (colours are read relative to the cube's current centers), nullopt when a slot holds no valid piece
+    static std::optional<CubieCube> fromCube(const Cube& c);
+    Cube toCube() const;
+
+    //Moves, using the codes in Moves.h
+    void applyMove(int move);
+    void applyMoves(const std::uint8_t* moves, std::size_t n);
+    void multiply(const CubieCube& b);	//this = this * b
+
+    //Location (0..23 in EDGE_POSITIONS numbering) of each edge piece's reference sticker
+    std::array<std::uint8_t, 12> edgeLocations() const;
+    //Location (0..23 in CORNER_POSITIONS numbering) of each corner piece's U/D sticker
+    std::array<std::uint8_t, 8> cornerLocations() const;
+
+    bool operator==(const CubieCube& o) const;
+    bool operator!=(const CubieCube& o) const { return !(*this == o); }
+
+    static const CubieCube& move(int m);
+};
+
+#endif
@@ -0,0 +1,57 @@
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "DistanceTable.h"
+
+namespace {
+    constexpr char MAGIC[8] = {'X', 'S', 'D', 'I', 'S', 'T', '0', '1'};
+    constexpr std::size_t TAG_LEN = 32;
+}
+
+bool dist::load(const std::string& path, const std::string& tag, std::size_t states, std::vector<std::uint8_t>& table){
+    std::ifstream in(path, std::ios::binary);
+    if(!in) return false;
+
+    char magic[8];
+    char fileTag[TAG_LEN];
+    std::uint64_t size = 0;
+    in.read(magic, sizeof(magic));
+    in.read(fileTag, sizeof(fileTag));
+    in.read(reinterpret_cast<char*>(&size), sizeof(size));
+    if(!in || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) return false;
+    if(std::string(fileTag, strnlen(fileTag, TAG_LEN)) != tag.substr(0, TAG_LEN) || size != states) return false;
+
+    std::vector<std::uint8_t> data(states);
+    in.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(states));
+    if(!in) return false;
+    table = std::move(data);
+    return true;
+}
+
+bool dist::save(const std::string& path, const std::string& tag, const std::vector<std::uint8_t>& table){
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if(!out) return false;
+
+    char fileTag[TAG_LEN] = {};
+    std::memcpy(fileTag, tag.data(), std::min(tag.size(), TAG_LEN));
+    std::uint64_t size = table.size();
+    out.write(MAGIC, sizeof(MAGIC));
+    out.write(fileTag, sizeof(fileTag));
+    out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    out.write(reinterpret_cast<const char*>(table.data()), static_cast<std::streamsize>(table.size()));
+    return static_cast<bool>(out);
+}
+
+std::vector<std::uint8_t> dist::loadOrBuild(const std::string& dir, const std::string& name, std::size_t states,
+					    const std::function<std::vector<std::uint8_t>()>& build){
+    std::vector<std::uint8_t> table;
+    std::string path = dir.empty() ? "" : dir + "/" + name + ".dist";
+    if(!path.empty() && load(path, name, states, table)) return table;
+
+    table = build();
+    if(!path.empty() && !save(path, name, table)){
+	std::cerr << "could not write pruning table " << path << std::endl;
+    }
+    return table;
+}
@@ -0,0 +1,102 @@
+#ifndef DISTANCE_TABLE_H
+#define DISTANCE_TABLE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dist {
+
+    constexpr std::uint8_t UNREACHED = 0xFF;
+
+    /*
+     * Breadth-first distances from a set of goal states over a coordinate
+     * space of `states` slots. next(s, m) gives the state after move m, or
+     * `states` when the move can't be applied. The move set has to be closed
+     * under inverses (every face turn comes with its inverse), so distance
+     * from the goal equals distance to it.
+     *
+     * Level-synchronous: each level's frontier is split across threads by
+     * index range and states are claimed with a relaxed compare-exchange. A
+     * state's level is unique, so the table is the same for any thread count.
+     */
+    template <typename Next>
+    std::vector<std::uint8_t> bfs(std::size_t states, const std::vector<std::size_t>& goals, int moveCount, Next next, unsigned threads) {
+	std::unique_ptr<std::atomic<std::uint8_t>[]> d(new std::atomic<std::uint8_t>[states]);
+	for(std::size_t i = 0; i < states; i++) d[i].store(UNREACHED, std::memory_order_relaxed);
+
+	std::vector<std::size_t> frontier;
+	for(std::size_t g : goals){
+	    if(d[g].load(std::memory_order_relaxed) == UNREACHED){
+		d[g].store(0, std::memory_order_relaxed);
+		frontier.push_back(g);
+	    }
+	}
+	if(threads == 0) threads = 1;
+
+	for(std::uint8_t level = 0; !frontier.empty() && level + 1 < UNREACHED; level++){
+	    unsigned workers = static_cast<unsigned>(std::min<std::size_t>(threads, (frontier.size() + 4095) / 4096));
+	    if(workers == 0) workers = 1;
+	    std::vector<std::vector<std::size_t>> found(workers);
+
+	    auto expand = [&](unsigned w){
+		std::size_t begin = frontier.size() * w / workers;
+		std::size_t end = frontier.size() * (w + 1) / workers;
+		std::uint8_t nextLevel = static_cast<std::uint8_t>(level + 1);
+		for(std::size_t i = begin; i < end; i++){
+		    for(int m = 0; m < moveCount; m++){
+			std::size_t t = next(frontier[i], m);
+			if(t >= states) continue;
+			std::uint8_t expected = UNREACHED;
+			if(d[t].load(std::memory_order_relaxed) == UNREACHED &&
+			   d[t].compare_exchange_strong(expected, nextLevel, std::memory_order_relaxed)){
+			    found[w].push_back(t);
+			}
+		    }
+		}
+	    };
+
+	    if(workers == 1){
+		expand(0);
+	    } else {
+		std::vector<std::thread> pool;
+		for(unsigned w = 0; w < workers; w++) pool.emplace_back(expand, w);
+		for(std::thread& t : pool) t.join();
+	    }
+
+	    frontier.clear();
+	    for(auto& f : found) frontier.insert(frontier.end(), f.begin(), f.end());
+	    // which thread claimed a state is racy, the set isn't
+	    std::sort(frontier.begin(), frontier.end());
+	}
+
+	std::vector<std::uint8_t> res(states);
+	for(std::size_t i = 0; i < states; i++) res[i] = d[i].load(std::memory_order_relaxed);
+	return res;
+    }
+
+    /*
+     * Pruning tables cached on disk as a small header (magic, tag, size)
+     * followed by the raw bytes. load() fails on any mismatch so a stale or
+     * foreign file just gets rebuilt.
+     */
+    bool load(const std::string& path, const std::string& tag, std::size_t states, std::vector<std::uint8_t>& table);
+    bool save(const std::string& path, const std::string& tag, const std::vector<std::uint8_t>& table);
+
+    /*
+     * The table cached as dir/name.dist (tagged `name`): loaded when it's
+     * there and matches, otherwise built and saved. An empty dir never
+     * touches the disk. A failed save is reported on std::cerr, the table is
+     * still returned.
+     */
+    std::vector<std::uint8_t> loadOrBuild(const std::string& dir, const std::string& name, std::size_t states,
+					  const std::function<std::vector<std::uint8_t>()>& build);
+}
+
+#endif
@@ -0,0 +1,372 @@
+#include <map>
+
+#include "DrillGenerator.h"
+#include "CompactCrossTable.h"
+#include "CrossConstants.hpp"
+#include "CrossCoords.h"
+#include "CrossDistance.h"
+#include "CrossSymmetry.h"
+#include "Cube.h"
+#include "IdaSearch.h"
+#include "Moves.h"
+
+namespace {
+
+    // appends a move, merging it into the last one when they turn the same face
+    void push(std::vector<std::uint8_t>& out, int m){
+	if(!out.empty() && moves::face(out.back()) == moves::face(m)){
+	    // quarter turns clockwise: turn 0 = 1, turn 1 = 3, turn 2 = 2
+	    constexpr int quarters[3] = {1, 3, 2};
+	    constexpr int turnOf[4] = {-1, 0, 2, 1};
+	    int q = (quarters[moves::turn(out.back())] + quarters[moves::turn(m)]) % 4;
+	    int f = moves::face(m);
+	    out.pop_back();
+	    if(q != 0) push(out, 3 * f + turnOf[q]);
+	    return;
+	}
+	out.push_back(static_cast<std::uint8_t>(m));
+    }
+
+    // ORIENTATIONS lists the four fronts of a colour together, colours c and c ^ 1 are opposite
+    int colourDistance(const cross::EdgeLocations& loc, int colour){
+	return cross::compactDistance(cross::packIndex(cross::crossLocations(loc, cross::orientationTables()[4 * colour])));
+    }
+
+    // big classes are sampled, only classes this small (in White crosses at least depth away) are enumerated
+    constexpr std::size_t EXHAUSTIVE_TARGETS = 2000;
+    constexpr std::size_t POOL_SIZE = 1024;
+    constexpr std::size_t REFRESH_EVERY = 128;
+
+    /*
+     * Places pieces order[k..] into the free slots (bit set in `used` =
+     * taken). The last piece's flip is forced so the flips add up to even.
+     * The opposite cross is checked once its four pieces are down.
+     */
+    void placeRest(cross::EdgeLocations& loc, const std::array<int, 8>& order, int k, unsigned used, int parity, int depth,
+		   std::vector<cross::EdgeLocations>& out){
+	if(k == 8){
+	    int best = cross::COMPACT_UNREACHED;
+	    for(int c = 0; c < 6; c++){
+		int d = colourDistance(loc, c);
+		if(d < depth) return;
+		if(d < best) best = d;
+	    }
+	    if(best == depth) out.push_back(loc);
+	    return;
+	}
+	for(int slot = 0; slot < 12; slot++){
+	    if(used & (1u << slot)) continue;
+	    for(int flip = 0; flip < 2; flip++){
+		if(k == 7 && flip != parity) continue;
+		loc[order[k]] = static_cast<std::uint8_t>(2 * slot + flip);
+		if(k == 3 && colourDistance(loc, 1) < depth) continue;
+		placeRest(loc, order, k + 1, used | (1u << slot), parity ^ flip, depth, out);
+	    }
+	}
+    }
+
+    // IDA* until the listed colours' crosses are solved, giving up after `budget` nodes
+    struct EdgeStage {
+	const int* colours;
+	int count;
+	std::size_t& budget;
+	moves::Sequence path;
+
+	enum Result { NONE, FOUND, OUT_OF_BUDGET };
+
+	// stops at the first cross more than `limit` away, that's enough to prune
+	int h(const cross::EdgeLocations& s, int limit) const {
+	    int best = 0;
+	    for(int i = 0; i < count && best <= limit; i++){
+		int d = colourDistance(s, colours[i]);
+		if(d > best) best = d;
+	    }
+	    return best;
+	}
+
+	Result dfs(const cross::EdgeLocations& s, int g, int bound, int prev){
+	    int hv = h(s, bound - g);
+	    if(hv == 0){
+		path.length = static_cast<std::uint8_t>(g);
+		return FOUND;
+	    }
+	    if(g + hv > bound) return NONE;
+	    if(budget == 0) return OUT_OF_BUDGET;
+	    budget--;
+	    const cross::MoveTable& next = cross::edgeMoveTable();
+	    for(int m = 0; m < moves::COUNT; m++){
+		if(!ida::canFollow(prev, m)) continue;
+		path.moves[g] = static_cast<std::uint8_t>(m);
+		cross::EdgeLocations t = s;
+		cross::applyMove(t, m, next);
+		Result r = dfs(t, g + 1, bound, m);
+		if(r != NONE) return r;
+	    }
+	    return NONE;
+	}
+    };
+
+    /*
+     * Solves every edge (corners are ignored) in stages: the cross of
+     * `first`, then the opposite cross as well, then one more, then all six.
+     * Each stage keeps what the earlier ones solved. False when `budget`
+     * nodes weren't enough.
+     */
+    bool solveEdges(cross::EdgeLocations loc, int first, std::size_t budget, std::vector<std::uint8_t>& sol){
+	int colours[6] = {first, first ^ 1};
+	for(int c = 0, n = 2; c < 6; c++){
+	    if(c != first && c != (first ^ 1)) colours[n++] = c;
+	}
+	const int counts[4] = {1, 2, 3, 6};
+	for(int count : counts){
+	    EdgeStage stage{colours, count, budget, {}};
+	    EdgeStage::Result r = EdgeStage::NONE;
+	    for(int bound = stage.h(loc, cross::COMPACT_UNREACHED); bound <= static_cast<int>(stage.path.moves.size()) && r == EdgeStage::NONE; bound++){
+		r = stage.dfs(loc, 0, bound, -1);
+	    }
+	    if(r != EdgeStage::FOUND) return false;
+	    for(int i = 0; i < stage.path.length; i++){
+		sol.push_back(stage.path.moves[i]);
+		cross::applyMove(loc, stage.path.moves[i]);
+	    }
+	}
+	return true;
+    }
+
+    // a scramble that leaves the edges in `loc`: every start colour gets the same node budget, then four times as much
+    std::vector<std::uint8_t> edgeScramble(const cross::EdgeLocations& loc){
+	std::vector<std::uint8_t> sol;
+	for(std::size_t budget = std::size_t(1) << 16; ; budget *= 4){
+	    for(int first = 0; first < 6; first++){
+		sol.clear();
+		if(!solveEdges(loc, first, budget, sol)) continue;
+		std::vector<std::uint8_t> out;
+		for(std::size_t i = sol.size(); i-- > 0;) push(out, moves::inverse(sol[i]));
+		return out;
+	    }
+	}
+    }
+}
+
+DrillGenerator::DrillGenerator(std::uint64_t seed, int walkLength) : rng_(seed), walkLength_(walkLength) {}
+
+int DrillGenerator::orientationForColour(char colour){
+    Cube solved;
+    for(int o = 0; o < 24; o++){
+	if(solved.getColorAtPosition(cross::ORIENTATIONS[o].first, 1, 1) == colour) return o;
+    }
+    return -1;
+}
+
+const std::vector<std::uint32_t>& DrillGenerator::statesAt_(int depth){
+    std::vector<std::uint32_t>& states = byDepth_[depth];
+    if(states.empty()){
+	for(std::size_t idx = 0; idx < cross::STATES; idx++){
+	    if(cross::compactDistance(idx) == depth) states.push_back(static_cast<std::uint32_t>(idx));
+	}
+    }
+    return states;
+}
+
+void DrillGenerator::walk_(std::vector<std::uint8_t>& out, cross::EdgeLocations& loc){
+    // canonical order, so nothing in it cancels or commutes away
+    const cross::MoveTable& next = cross::edgeMoveTable();
+    out.clear();
+    loc = cross::SOLVED_EDGES;
+    std::uniform_int_distribution<int> pickMove(0, moves::COUNT - 1);
+    int prev = -1;
+    for(int k = 0; k < walkLength_; k++){
+	int m;
+	do { m = pickMove(rng_); } while(!ida::canFollow(prev, m));
+	out.push_back(static_cast<std::uint8_t>(m));
+	cross::applyMove(loc, m, next);
+	prev = m;
+    }
+}
+
+bool DrillGenerator::singleColour_(int depth, int orientation, std::vector<std::uint8_t>& out){
+    const std::vector<std::uint32_t>& states = statesAt_(depth);
+    if(states.empty()) return false;
+    const cross::OrientationTable& frame = cross::orientationTables()[orientation];
+
+    std::uniform_int_distribution<std::size_t> pickState(0, states.size() - 1);
+    std::array<int, 4> target = cross::unpackIndex(states[pickState(rng_)]);
+
+    cross::EdgeLocations loc;
+    walk_(out, loc);
+
+    moves::Sequence solve = cross::compactSolution(cross::crossLocations(loc, frame));
+    for(int i = 0; i < solve.length; i++) push(out, cross::physicalMove(solve.moves[i], frame));
+
+    moves::Sequence toTarget = cross::compactSolution(target);
+    for(int i = toTarget.length - 1; i >= 0; i--) push(out, cross::physicalMove(moves::inverse(toTarget.moves[i]), frame));
+    return true;
+}
+
+DrillGenerator::NeutralPlan& DrillGenerator::neutralPlan_(int depth){
+    NeutralPlan& plan = neutral_[depth];
+    if(plan.ready) return plan;
+    plan.ready = true;
+
+    std::size_t atLeast = 0;
+    for(int d = depth; d < cross::COMPACT_UNREACHED; d++) atLeast += statesAt_(d).size();
+    if(atLeast <= EXHAUSTIVE_TARGETS){
+	plan.exhaustive = true;
+	enumerateNeutral_(depth, plan);
+	return plan;
+    }
+
+    // White at least depth away needs no correction, exactly depth keeps fewer draws once that's a small part of it
+    plan.atLeast = atLeast < 6 * statesAt_(depth).size();
+    for(int d = depth; d < (plan.atLeast ? cross::COMPACT_UNREACHED : depth + 1); d++){
+	const std::vector<std::uint32_t>& states = statesAt_(d);
+	plan.targets.insert(plan.targets.end(), states.begin(), states.end());
+    }
+    plan.tails.resize(plan.targets.size());
+    plan.tailReady.resize(plan.targets.size());
+    return plan;
+}
+
+void DrillGenerator::enumerateNeutral_(int depth, NeutralPlan& plan){
+    const cross::OrientationTable& white = cross::orientationTables()[0];
+    const cross::OrientationTable& yellow = cross::orientationTables()[4];
+    // the opposite cross's pieces first, then the four nobody's cross shares with White or it
+    std::array<int, 8> order;
+    unsigned crossPieces = 0;
+    for(int k = 0; k < 4; k++){
+	order[k] = yellow.crossEdge[k] >> 1;
+	crossPieces |= 1u << (white.crossEdge[k] >> 1);
+	crossPieces |= 1u << (yellow.crossEdge[k] >> 1);
+    }
+    for(int p = 0, n = 4; p < 12; p++){
+	if(!(crossPieces & (1u << p))) order[n++] = p;
+    }
+
+    std::vector<cross::EdgeLocations> states;
+    cross::EdgeLocations loc = cross::SOLVED_EDGES;
+    for(int d = depth; d < cross::COMPACT_UNREACHED; d++){
+	for(std::uint32_t idx : statesAt_(d)){
+	    std::array<int, 4> pos = cross::unpackIndex(idx);
+	    unsigned used = 0;
+	    int parity = 0;
+	    for(int k = 0; k < 4; k++){
+		int s = white.crossEdge[k];
+		loc[s >> 1] = static_cast<std::uint8_t>(white.physical[pos[k]] ^ (s & 1));
+		used |= 1u << (loc[s >> 1] >> 1);
+		parity ^= loc[s >> 1] & 1;
+	    }
+	    placeRest(loc, order, 0, used, parity, depth, states);
+	}
+    }
+    // whole-cube rotations keep the class, so one search covers every rotation of a state
+    std::map<cross::EdgeLocations, std::size_t> index;
+    for(std::size_t i = 0; i < states.size(); i++) index[states[i]] = i;
+    const auto& tables = cross::orientationTables();
+    plan.scrambles.resize(states.size());
+    for(std::size_t i = 0; i < states.size(); i++){
+	if(!plan.scrambles[i].empty()) continue;
+	std::vector<std::uint8_t> found = edgeScramble(states[i]);
+	for(int o = 0; o < 24; o++){
+	    std::vector<std::uint8_t> turned = found;
+	    for(std::uint8_t& m : turned) m = static_cast<std::uint8_t>(cross::physicalMove(cross::frameMove(m, tables[0]), tables[o]));
+	    cross::EdgeLocations at = cross::SOLVED_EDGES;
+	    cross::applyMoves(at, turned.data(), turned.size());
+	    auto it = index.find(at);
+	    if(it != index.end() && plan.scrambles[it->second].empty()) plan.scrambles[it->second] = std::move(turned);
+	}
+    }
+}
+
+DrillGenerator::Rest DrillGenerator::makeRest_(){
+    const cross::OrientationTable& white = cross::orientationTables()[0];
+    const cross::MoveTable& next = cross::edgeMoveTable();
+    Rest r;
+    walk_(r.moves, r.loc);
+    moves::Sequence solve = cross::compactSolution(cross::crossLocations(r.loc, white));
+    for(int i = 0; i < solve.length; i++){
+	int m = cross::physicalMove(solve.moves[i], white);
+	push(r.moves, m);
+	cross::applyMove(r.loc, m, next);
+    }
+    return r;
+}
+
+void DrillGenerator::appendTail_(std::uint32_t target, std::vector<std::uint8_t>& out){
+    const cross::OrientationTable& white = cross::orientationTables()[0];
+    moves::Sequence toTarget = cross::compactSolution(cross::unpackIndex(target));
+    for(int k = toTarget.length - 1; k >= 0; k--) push(out, cross::physicalMove(moves::inverse(toTarget.moves[k]), white));
+}
+
+const std::array<std::uint8_t, 24>& DrillGenerator::tail_(NeutralPlan& plan, std::size_t i){
+    std::array<std::uint8_t, 24>& map = plan.tails[i];
+    if(plan.tailReady[i]) return map;
+    const cross::MoveTable& next = cross::edgeMoveTable();
+    std::vector<std::uint8_t> moves;
+    appendTail_(plan.targets[i], moves);
+    for(int l = 0; l < 24; l++){
+	int at = l;
+	for(std::uint8_t m : moves) at = next[at][m];
+	map[l] = static_cast<std::uint8_t>(at);
+    }
+    plan.tailReady[i] = true;
+    return map;
+}
+
+bool DrillGenerator::exists(int depth, int orientation){
+    if(depth < 0 || depth >= cross::COMPACT_UNREACHED) return false;
+    if(orientation != NEUTRAL) return !statesAt_(depth).empty();
+    // sampled classes are the shallow ones, every one of those turns up among random states
+    const NeutralPlan& plan = neutralPlan_(depth);
+    return !plan.exhaustive || !plan.scrambles.empty();
+}
+
+bool DrillGenerator::next(int depth, int orientation, std::vector<std::uint8_t>& out, std::size_t maxTries){
+    if(depth < 0 || depth >= cross::COMPACT_UNREACHED) return false;
+    if(orientation != NEUTRAL) return singleColour_(depth, orientation, out);
+
+    NeutralPlan& plan = neutralPlan_(depth);
+    if(plan.exhaustive){
+	if(plan.scrambles.empty()) return false;
+	std::uniform_int_distribution<std::size_t> pick(0, plan.scrambles.size() - 1);
+	out = plan.scrambles[pick(rng_)];
+	return true;
+    }
+
+    while(pool_.size() < POOL_SIZE) pool_.push_back(makeRest_());
+    const auto& tables = cross::orientationTables();
+    std::uniform_int_distribution<std::size_t> pickRest(0, pool_.size() - 1);
+    for(std::size_t tries = 0; tries < maxTries; tries++){
+	if(++draws_ % REFRESH_EVERY == 0) pool_[pickRest(rng_)] = makeRest_();
+	// both picks from one draw, 32 bits each (multiply-shift, off from uniform by under n / 2^32)
+	std::uint64_t r = rng_();
+	const Rest& rest = pool_[((r & 0xFFFFFFFF) * pool_.size()) >> 32];
+	std::size_t target = ((r >> 32) * plan.targets.size()) >> 32;
+	const std::array<std::uint8_t, 24>& tail = tail_(plan, target);
+	cross::EdgeLocations loc;
+	for(int p = 0; p < 12; p++) loc[p] = tail[rest.loc[p]];
+
+	// White is never shorter than depth, look at it last
+	int atDepth = 0;
+	bool shorter = false;
+	for(int c = 1; c < 6 && !shorter; c++){
+	    int d = colourDistance(loc, c);
+	    shorter = d < depth;
+	    atDepth += d == depth;
+	}
+	if(shorter) continue;
+	atDepth += cross::compactDistance(plan.targets[target]) == depth;
+	if(atDepth == 0) continue;
+	// a state with k colours at depth is drawn k times as often through White
+	if(!plan.atLeast && atDepth > 1 && std::uniform_int_distribution<int>(0, atDepth - 1)(rng_) != 0) continue;
+
+	out = rest.moves;
+	appendTail_(plan.targets[target], out);
+	if(!plan.atLeast){
+	    // White stood in for a random colour: the same turns with that colour held where White was
+	    int colour = std::uniform_int_distribution<int>(0, 5)(rng_);
+	    for(std::uint8_t& m : out) m = static_cast<std::uint8_t>(cross::physicalMove(cross::frameMove(m, tables[0]), tables[4 * colour]));
+	}
+	return true;
+    }
+    return false;
+}
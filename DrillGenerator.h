@@ -0,0 +1,93 @@
+#ifndef DRILL_GENERATOR_H
+#define DRILL_GENERATOR_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "CrossSymmetry.h"
+
+/*
+ * Scrambles whose optimal cross is exactly `depth` moves, for one colour or
+ * colour neutral (best of the six is exactly `depth`).
+ *
+ * For one colour the target cross state is drawn uniformly from every state
+ * at that distance in the compact distance table. The scramble is a random
+ * walk R, then the table solution for R's cross, then the inverse of the
+ * target's solution: R brings everything else out of place, the middle part
+ * solves the cross again and the tail puts it in the target state.
+ * Neighbouring turns of the same face are merged.
+ *
+ * Colour neutral samples uniformly over whole edge states (corners don't
+ * matter to any cross). Each depth is set up once:
+ *  - Deep classes, where few states of one colour's cross are at least
+ *    `depth` away, are enumerated exactly: that cross, then the opposite
+ *    one, then the four edges left, pruning on distance. An empty class is
+ *    known up front. Every state is turned into a scramble by a staged
+ *    IDA* (one cross, the opposite cross too, one more, then all six).
+ *  - Otherwise White's cross is drawn from the distance table as for one
+ *    colour, either at least `depth` or exactly `depth` (then for a random
+ *    colour and kept with probability 1 / number of colours at `depth`),
+ *    whichever keeps more draws. The rest of the edges come from a pool of
+ *    random walks with White's cross solved, and where the tail for each
+ *    target sends every sticker is cached, so a draw is 12 lookups plus
+ *    the six distances. The tail's moves are only worked out for a kept
+ *    draw. One pool entry is replaced every few draws, independent of
+ *    what was kept.
+ */
+class DrillGenerator {
+private:
+    // a random walk followed by the solution of White's cross
+    struct Rest {
+	cross::EdgeLocations loc;
+	std::vector<std::uint8_t> moves;
+    };
+
+    struct NeutralPlan {
+	bool ready = false;
+	bool exhaustive = false;
+	std::vector<std::vector<std::uint8_t>> scrambles;	//exhaustive: one per edge state in the class
+	bool atLeast = false;				//targets are White crosses at least depth away, not exactly
+	std::vector<std::uint32_t> targets;
+	std::vector<std::array<std::uint8_t, 24>> tails;	//where the inverse of a target's solution sends every edge sticker
+	std::vector<bool> tailReady;
+    };
+
+    std::mt19937_64 rng_;
+    int walkLength_;
+    std::array<std::vector<std::uint32_t>, 16> byDepth_;	//cross indices per distance, filled on first use
+    std::array<NeutralPlan, 16> neutral_;
+    std::vector<Rest> pool_;
+    std::size_t draws_ = 0;
+
+    const std::vector<std::uint32_t>& statesAt_(int depth);
+    void walk_(std::vector<std::uint8_t>& out, cross::EdgeLocations& loc);
+    bool singleColour_(int depth, int orientation, std::vector<std::uint8_t>& out);
+    NeutralPlan& neutralPlan_(int depth);
+    void enumerateNeutral_(int depth, NeutralPlan& plan);
+    Rest makeRest_();
+    const std::array<std::uint8_t, 24>& tail_(NeutralPlan& plan, std::size_t i);
+    void appendTail_(std::uint32_t target, std::vector<std::uint8_t>& out);
+
+public:
+    static constexpr int NEUTRAL = -1;
+
+    //Constructor
+    explicit DrillGenerator(std::uint64_t seed, int walkLength = 20);
+
+    //First entry in cross::ORIENTATIONS with that colour on Down ('W', 'Y', ...), -1 if there is none
+    static int orientationForColour(char colour);
+
+    //False when no edge state has that depth; colour neutral sets the depth up on first use
+    bool exists(int depth, int orientation);
+
+    /*
+     * Writes move codes (unrotated cube) into `out`. orientation picks the
+     * cross colour, or NEUTRAL. False when no state has that depth or, for
+     * colour neutral, nothing turned up in `maxTries` draws.
+     */
+    bool next(int depth, int orientation, std::vector<std::uint8_t>& out, std::size_t maxTries = 100000000);
+};
+
+#endif
@@ -0,0 +1,117 @@
+#include "EOCrossSolver.h"
+#include "CrossCoords.h"
+#include "CrossDistance.h"
+#include "DistanceTable.h"
+#include "FrameSweep.h"
+#include "IdaSearch.h"
+
+namespace {
+
+    constexpr std::size_t EO_STATES = 1 << 11;
+    constexpr std::size_t PAIRS = 24 * 24;
+    constexpr std::size_t STATES = EO_STATES * PAIRS;
+
+    // down stickers of DF, DL, DB, DR
+    constexpr std::uint8_t DF = 16;
+    constexpr std::uint8_t DL = 18;
+    constexpr std::uint8_t DB = 20;
+    constexpr std::uint8_t DR = 22;
+
+    // optimal EOCross is at most 10 or so
+    constexpr int MAX_DEPTH = 16;
+
+    using OrientationMoves = std::array<std::array<std::uint16_t, moves::COUNT>, EO_STATES>;
+
+    // next[eo][m], the slot orientation bits after move m
+    const OrientationMoves& orientationMoves(){
+	static const OrientationMoves table = []{
+	    const cross::MoveTable& edgeMoves = cross::edgeMoveTable();
+	    OrientationMoves t;
+	    for(std::size_t eo = 0; eo < EO_STATES; eo++){
+		unsigned parity = static_cast<unsigned>(__builtin_popcount(static_cast<unsigned>(eo)) & 1);
+		unsigned bits = static_cast<unsigned>(eo) | (parity << 11);
+		for(int m = 0; m < moves::COUNT; m++){
+		    unsigned out = 0;
+		    for(int s = 0; s < 12; s++){
+			std::uint8_t to = edgeMoves[2 * s + ((bits >> s) & 1)][m];
+			out |= static_cast<unsigned>(to & 1) << (to >> 1);
+		    }
+		    t[eo][m] = static_cast<std::uint16_t>(out & (EO_STATES - 1));
+		}
+	    }
+	    return t;
+	}();
+	return table;
+    }
+
+    struct State {
+	std::uint16_t eo;
+	std::array<int, 4> cross;	//DF, DR, DB, DL as in getCrossLocations()
+    };
+
+    std::size_t lineIndex(std::uint16_t eo, int a, int b){
+	return eo * PAIRS + static_cast<std::size_t>(a) * 24 + static_cast<std::size_t>(b);
+    }
+
+    std::vector<std::uint8_t> buildTable(std::uint8_t a, std::uint8_t b, unsigned threads){
+	const cross::MoveTable& edgeMoves = cross::edgeMoveTable();
+	const OrientationMoves& eoMoves = orientationMoves();
+	auto next = [&](std::size_t idx, int m){
+	    std::uint16_t eo = static_cast<std::uint16_t>(idx / PAIRS);
+	    return lineIndex(eoMoves[eo][m], edgeMoves[(idx / 24) % 24][m], edgeMoves[idx % 24][m]);
+	};
+	return dist::bfs(STATES, {lineIndex(0, a, b)}, moves::COUNT, next, threads);
+    }
+}
+
+EOCrossSolver::EOCrossSolver(const std::string& tableDir, unsigned threads) {
+    lineFB_ = dist::loadOrBuild(tableDir, "eoline-fb", STATES, [&]{ return buildTable(DF, DB, threads); });
+    lineLR_ = dist::loadOrBuild(tableDir, "eoline-lr", STATES, [&]{ return buildTable(DL, DR, threads); });
+    cross::distanceTable();
+}
+
+std::uint16_t EOCrossSolver::orientation(const cross::EdgeLocations& edges){
+    unsigned bits = 0;
+    for(std::uint8_t l : edges) bits |= static_cast<unsigned>(l & 1) << (l >> 1);
+    return static_cast<std::uint16_t>(bits & (EO_STATES - 1));
+}
+
+moves::Sequence EOCrossSolver::solve(const cross::EdgeLocations& edges, Goal goal) const {
+    const cross::MoveTable& edgeMoves = cross::edgeMoveTable();
+    const OrientationMoves& eoMoves = orientationMoves();
+    const std::uint8_t* crossDist = cross::distanceTable().data();
+    const std::uint8_t* fb = lineFB_.data();
+    const std::uint8_t* lr = lineLR_.data();
+
+    auto h = [&](const State& s){
+	int d = fb[lineIndex(s.eo, s.cross[0], s.cross[2])];
+	if(goal == Goal::EOLINE) return d;
+	int e = lr[lineIndex(s.eo, s.cross[3], s.cross[1])];
+	int c = crossDist[cross::packIndex(s.cross)];
+	if(e > d) d = e;
+	return c > d ? c : d;
+    };
+    auto apply = [&](const State& s, int m){
+	return State{eoMoves[s.eo][m], cross::applyMove(s.cross, m, edgeMoves)};
+    };
+
+    State start{orientation(edges), {edges[8], edges[11], edges[10], edges[9]}};
+    moves::Sequence sol;
+    ida::solve(start, MAX_DEPTH, h, apply, sol);
+    return sol;
+}
+
+std::array<moves::Sequence, 24> EOCrossSolver::solveAll(const cross::EdgeLocations& edges, Goal goal, unsigned threads) const {
+    const auto& tables = cross::orientationTables();
+
+    // corners don't matter here, only the edges are oriented
+    std::array<moves::Sequence, 24> res;
+    cross::forEachCase(24, threads, [&](int o){
+	res[o] = solve(cross::orientEdges(edges, tables[o]), goal);
+    });
+    return res;
+}
+
+std::array<moves::Sequence, 24> EOCrossSolver::solveAll(const CubieCube& cc, Goal goal, unsigned threads) const {
+    return solveAll(cc.edgeLocations(), goal, threads);
+}
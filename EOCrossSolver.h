@@ -0,0 +1,53 @@
+#ifndef EO_CROSS_SOLVER_H
+#define EO_CROSS_SOLVER_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "CrossSymmetry.h"
+#include "CubieCube.h"
+#include "Moves.h"
+
+/*
+ * Optimal EOCross / EOLine for ZZ by IDA*.
+ *
+ * Every edge's reference sticker sits on an even EDGE_POSITIONS index
+ * exactly when the edge is oriented for the front/back axis (only F and B
+ * quarter turns change that), so the orientation of the edge in each slot
+ * is one bit and the 12 slots make an 11-bit coordinate (the last bit is
+ * the parity of the others).
+ *
+ * The search state is that coordinate plus the four cross edges. It is
+ * pruned with two tables over (orientation x DF x DB) and (orientation x
+ * DL x DR), 2^11 * 24^2 bytes each, and the cross distance table. The first
+ * one alone is exact for EOLine (all edges oriented, DF and DB solved).
+ * Every orientation is searched in its own frame after cross::orientEdges,
+ * so moves come out in that frame and "front" is the orientation's front.
+ */
+class EOCrossSolver {
+public:
+    enum class Goal {
+	EOCROSS,
+	EOLINE
+    };
+
+    //Constructor: loads the pruning tables from tableDir, building (and saving) them when missing
+    explicit EOCrossSolver(const std::string& tableDir = "", unsigned threads = 1);
+
+    //One entry per cross::ORIENTATIONS, the 24 searches spread over `threads`
+    std::array<moves::Sequence, 24> solveAll(const CubieCube& cc, Goal goal, unsigned threads = 1) const;
+    std::array<moves::Sequence, 24> solveAll(const cross::EdgeLocations& edges, Goal goal, unsigned threads = 1) const;
+
+    //Goal on D with F in front, for a state already expressed in the frame to solve in
+    moves::Sequence solve(const cross::EdgeLocations& edges, Goal goal) const;
+
+    //Orientation bits of slots 0..10 (EDGE_POSITIONS index / 2), 0 when every edge is oriented
+    static std::uint16_t orientation(const cross::EdgeLocations& edges);
+
+private:
+    std::vector<std::uint8_t> lineFB_;	//[orientation][DF][DB]
+    std::vector<std::uint8_t> lineLR_;	//[orientation][DL][DR]
+};
+
+#endif
@@ -0,0 +1,277 @@
+#include <algorithm>
+#include <array>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define EDGE_BATCH_X86 1
+#endif
+
+#include "EdgeBatch.h"
+#include "CompactCrossTable.h"
+#include "CrossCoords.h"
+#include "SolvingLogic.h"
+
+namespace {
+
+    // rows are padded to this many lanes so the vector loops never need a tail on their input
+    constexpr std::size_t kLaneBlock = 32;
+
+    // a 24-entry byte map padded to 32 so each half loads as one vector
+    using ByteMap = std::array<std::uint8_t, 32>;
+
+    struct Maps {
+	std::array<ByteMap, moves::COUNT> move;	//sticker location -> location after the move
+	std::array<std::array<std::uint8_t, 4>, 24> piece;	//cross pieces per orientation
+	std::array<std::array<ByteMap, 4>, 24> frame;	//their location -> cross position in that frame
+
+	Maps(){
+	    const cross::MoveTable& next = cross::edgeMoveTable();
+	    for(int m = 0; m < moves::COUNT; m++){
+		move[m].fill(0);
+		for(int l = 0; l < 24; l++) move[m][l] = next[l][m];
+	    }
+	    // crossLocations() reads relabel[loc[s >> 1] ^ (s & 1)], the xor folds into the map
+	    const auto& tables = cross::orientationTables();
+	    for(int o = 0; o < 24; o++){
+		for(int k = 0; k < 4; k++){
+		    int s = tables[o].crossEdge[k];
+		    piece[o][k] = static_cast<std::uint8_t>(s >> 1);
+		    frame[o][k].fill(0);
+		    for(int l = 0; l < 24; l++) frame[o][k][l] = tables[o].relabel[l ^ (s & 1)];
+		}
+	    }
+	}
+    };
+
+    const Maps& maps(){
+	static const Maps m;
+	return m;
+    }
+
+    // ----- scalar -----
+
+    void mapScalar(std::uint8_t* d, std::size_t n, const ByteMap& t){
+	for(std::size_t i = 0; i < n; i++) d[i] = t[d[i]];
+    }
+
+    void indicesScalar(const std::uint8_t* const r[4], const std::array<ByteMap, 4>& t, std::uint32_t* out, std::size_t begin, std::size_t n){
+	for(std::size_t i = begin; i < n; i++){
+	    out[i] = t[0][r[0][i]] + 24u * (t[1][r[1][i]] + 24u * (t[2][r[2][i]] + 24u * t[3][r[3][i]]));
+	}
+    }
+
+#ifdef EDGE_BATCH_X86
+
+    // ----- SSSE3, 16 lanes -----
+
+    // t[x] for bytes x < 24: the low shuffle sees x + 0x70 (bit 7 set, so zero, once x >= 16),
+    // the high one x - 16 (bit 7 set while x < 16)
+    __attribute__((target("ssse3")))
+    inline __m128i lookup16(__m128i x, __m128i lo, __m128i hi){
+	__m128i a = _mm_shuffle_epi8(lo, _mm_adds_epu8(x, _mm_set1_epi8(0x70)));
+	__m128i b = _mm_shuffle_epi8(hi, _mm_sub_epi8(x, _mm_set1_epi8(16)));
+	return _mm_or_si128(a, b);
+    }
+
+    __attribute__((target("ssse3")))
+    void mapSsse3(std::uint8_t* d, std::size_t n, const ByteMap& t){
+	__m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t.data()));
+	__m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t.data() + 16));
+	for(std::size_t i = 0; i < n; i += 16){
+	    __m128i* p = reinterpret_cast<__m128i*>(d + i);
+	    _mm_storeu_si128(p, lookup16(_mm_loadu_si128(p), lo, hi));
+	}
+    }
+
+    // 16-bit lanes: a + 24 * b
+    __attribute__((target("ssse3")))
+    inline __m128i pack24(__m128i a, __m128i b){
+	return _mm_add_epi16(a, _mm_add_epi16(_mm_slli_epi16(b, 4), _mm_slli_epi16(b, 3)));
+    }
+
+    // 32-bit lanes: a + 576 * b
+    __attribute__((target("ssse3")))
+    inline __m128i pack576(__m128i a, __m128i b){
+	return _mm_add_epi32(a, _mm_add_epi32(_mm_slli_epi32(b, 9), _mm_slli_epi32(b, 6)));
+    }
+
+    __attribute__((target("ssse3")))
+    void indicesSsse3(const std::uint8_t* const r[4], const std::array<ByteMap, 4>& t, std::uint32_t* out, std::size_t n){
+	__m128i lo[4], hi[4];
+	for(int k = 0; k < 4; k++){
+	    lo[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t[k].data()));
+	    hi[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t[k].data() + 16));
+	}
+	const __m128i zero = _mm_setzero_si128();
+	std::size_t i = 0;
+	for(; i + 16 <= n; i += 16){
+	    __m128i b[4];
+	    for(int k = 0; k < 4; k++) b[k] = lookup16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(r[k] + i)), lo[k], hi[k]);
+	    // p0 + 24 p1 and p2 + 24 p3 fit 16 bits, the full index needs 32
+	    __m128i aLo = pack24(_mm_unpacklo_epi8(b[0], zero), _mm_unpacklo_epi8(b[1], zero));
+	    __m128i aHi = pack24(_mm_unpackhi_epi8(b[0], zero), _mm_unpackhi_epi8(b[1], zero));
+	    __m128i cLo = pack24(_mm_unpacklo_epi8(b[2], zero), _mm_unpacklo_epi8(b[3], zero));
+	    __m128i cHi = pack24(_mm_unpackhi_epi8(b[2], zero), _mm_unpackhi_epi8(b[3], zero));
+	    __m128i* o = reinterpret_cast<__m128i*>(out + i);
+	    _mm_storeu_si128(o, pack576(_mm_unpacklo_epi16(aLo, zero), _mm_unpacklo_epi16(cLo, zero)));
+	    _mm_storeu_si128(o + 1, pack576(_mm_unpackhi_epi16(aLo, zero), _mm_unpackhi_epi16(cLo, zero)));
+	    _mm_storeu_si128(o + 2, pack576(_mm_unpacklo_epi16(aHi, zero), _mm_unpacklo_epi16(cHi, zero)));
+	    _mm_storeu_si128(o + 3, pack576(_mm_unpackhi_epi16(aHi, zero), _mm_unpackhi_epi16(cHi, zero)));
+	}
+	indicesScalar(r, t, out, i, n);
+    }
+
+    // ----- AVX2, 32 lanes (vpshufb shuffles within each 128-bit half, so the tables are broadcast) -----
+
+    __attribute__((target("avx2")))
+    inline __m256i lookup32(__m256i x, __m256i lo, __m256i hi){
+	__m256i a = _mm256_shuffle_epi8(lo, _mm256_adds_epu8(x, _mm256_set1_epi8(0x70)));
+	__m256i b = _mm256_shuffle_epi8(hi, _mm256_sub_epi8(x, _mm256_set1_epi8(16)));
+	return _mm256_or_si256(a, b);
+    }
+
+    __attribute__((target("avx2")))
+    inline __m256i broadcast16(const std::uint8_t* p){
+	return _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+    }
+
+    __attribute__((target("avx2")))
+    void mapAvx2(std::uint8_t* d, std::size_t n, const ByteMap& t){
+	__m256i lo = broadcast16(t.data());
+	__m256i hi = broadcast16(t.data() + 16);
+	for(std::size_t i = 0; i < n; i += 32){
+	    __m256i* p = reinterpret_cast<__m256i*>(d + i);
+	    _mm256_storeu_si256(p, lookup32(_mm256_loadu_si256(p), lo, hi));
+	}
+    }
+
+    __attribute__((target("avx2")))
+    void indicesAvx2(const std::uint8_t* const r[4], const std::array<ByteMap, 4>& t, std::uint32_t* out, std::size_t n){
+	__m256i lo[4], hi[4];
+	for(int k = 0; k < 4; k++){
+	    lo[k] = broadcast16(t[k].data());
+	    hi[k] = broadcast16(t[k].data() + 16);
+	}
+	std::size_t i = 0;
+	for(; i + 32 <= n; i += 32){
+	    __m256i b[4];
+	    for(int k = 0; k < 4; k++) b[k] = lookup32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(r[k] + i)), lo[k], hi[k]);
+	    for(int half = 0; half < 2; half++){
+		__m256i w[4];
+		for(int k = 0; k < 4; k++){
+		    __m128i bytes = half ? _mm256_extracti128_si256(b[k], 1) : _mm256_castsi256_si128(b[k]);
+		    w[k] = _mm256_cvtepu8_epi16(bytes);
+		}
+		__m256i a = _mm256_add_epi16(w[0], _mm256_mullo_epi16(w[1], _mm256_set1_epi16(24)));
+		__m256i c = _mm256_add_epi16(w[2], _mm256_mullo_epi16(w[3], _mm256_set1_epi16(24)));
+		for(int q = 0; q < 2; q++){
+		    __m128i a8 = q ? _mm256_extracti128_si256(a, 1) : _mm256_castsi256_si128(a);
+		    __m128i c8 = q ? _mm256_extracti128_si256(c, 1) : _mm256_castsi256_si128(c);
+		    __m256i idx = _mm256_add_epi32(_mm256_cvtepu16_epi32(a8), _mm256_mullo_epi32(_mm256_cvtepu16_epi32(c8), _mm256_set1_epi32(576)));
+		    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + 16 * half + 8 * q), idx);
+		}
+	    }
+	}
+	indicesScalar(r, t, out, i, n);
+    }
+
+#endif
+
+    bool supported(cross::EdgeBatch::Kernel k){
+	switch(k){
+	    case cross::EdgeBatch::Kernel::SCALAR: return true;
+#ifdef EDGE_BATCH_X86
+	    case cross::EdgeBatch::Kernel::SSSE3: return __builtin_cpu_supports("ssse3");
+	    case cross::EdgeBatch::Kernel::AVX2: return __builtin_cpu_supports("avx2");
+#else
+	    default: return false;
+#endif
+	}
+	return false;
+    }
+
+    void mapBytes(cross::EdgeBatch::Kernel k, std::uint8_t* d, std::size_t n, const ByteMap& t){
+#ifdef EDGE_BATCH_X86
+	if(k == cross::EdgeBatch::Kernel::AVX2) return mapAvx2(d, n, t);
+	if(k == cross::EdgeBatch::Kernel::SSSE3) return mapSsse3(d, n, t);
+#endif
+	(void)k;
+	mapScalar(d, n, t);
+    }
+}
+
+cross::EdgeBatch::EdgeBatch(std::size_t n) : n_(n), stride_((n + kLaneBlock - 1) / kLaneBlock * kLaneBlock), kernel_(bestKernel()) {
+    if(stride_ == 0) stride_ = kLaneBlock;
+    rows_.resize(12 * stride_);
+    // padding lanes hold a solved cube too, the kernels map them along with the rest
+    for(int p = 0; p < 12; p++) std::fill(row_(p), row_(p) + stride_, SOLVED_EDGES[p]);
+    maps();
+}
+
+void cross::EdgeBatch::set(std::size_t lane, const EdgeLocations& loc){
+    for(int p = 0; p < 12; p++) row_(p)[lane] = loc[p];
+}
+
+cross::EdgeLocations cross::EdgeBatch::get(std::size_t lane) const {
+    EdgeLocations loc;
+    for(int p = 0; p < 12; p++) loc[p] = row_(p)[lane];
+    return loc;
+}
+
+void cross::EdgeBatch::applyMove(int move){
+    mapBytes(kernel_, rows_.data(), rows_.size(), maps().move[move]);
+}
+
+void cross::EdgeBatch::applyMoves(const std::uint8_t* moves, std::size_t count){
+    // the whole sequence is one map of the 24 locations, so it is still one pass over the rows
+    const Maps& m = maps();
+    ByteMap seq{};
+    for(int l = 0; l < 24; l++) seq[l] = static_cast<std::uint8_t>(l);
+    for(std::size_t i = 0; i < count; i++){
+	for(int l = 0; l < 24; l++) seq[l] = m.move[moves[i]][seq[l]];
+    }
+    mapBytes(kernel_, rows_.data(), rows_.size(), seq);
+}
+
+void cross::EdgeBatch::crossIndices(int o, std::uint32_t* out) const {
+    const Maps& m = maps();
+    const std::uint8_t* r[4];
+    for(int k = 0; k < 4; k++) r[k] = row_(m.piece[o][k]);
+#ifdef EDGE_BATCH_X86
+    if(kernel_ == Kernel::AVX2) return indicesAvx2(r, m.frame[o], out, n_);
+    if(kernel_ == Kernel::SSSE3) return indicesSsse3(r, m.frame[o], out, n_);
+#endif
+    indicesScalar(r, m.frame[o], out, 0, n_);
+}
+
+void cross::EdgeBatch::solutions(int o, std::string_view* out) const {
+    std::vector<std::uint32_t> idx(n_);
+    crossIndices(o, idx.data());
+    for(std::size_t i = 0; i < n_; i++) out[i] = SolvingLogic::getCrossSolutionAt(idx[i]);
+}
+
+void cross::EdgeBatch::distances(int o, std::uint8_t* out) const {
+    std::vector<std::uint32_t> idx(n_);
+    crossIndices(o, idx.data());
+    for(std::size_t i = 0; i < n_; i++) out[i] = compactDistance(idx[i]);
+}
+
+void cross::EdgeBatch::setKernel(Kernel k){
+    while(!supported(k)) k = static_cast<Kernel>(static_cast<int>(k) - 1);
+    kernel_ = k;
+}
+
+cross::EdgeBatch::Kernel cross::EdgeBatch::bestKernel(){
+    if(supported(Kernel::AVX2)) return Kernel::AVX2;
+    if(supported(Kernel::SSSE3)) return Kernel::SSSE3;
+    return Kernel::SCALAR;
+}
+
+const char* cross::EdgeBatch::kernelName(Kernel k){
+    switch(k){
+	case Kernel::SCALAR: return "scalar";
+	case Kernel::SSSE3: return "ssse3";
+	case Kernel::AVX2: return "avx2";
+    }
+    return "?";
+}
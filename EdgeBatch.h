@@ -0,0 +1,67 @@
+#ifndef EDGE_BATCH_H
+#define EDGE_BATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "CrossSymmetry.h"
+
+namespace cross {
+
+    /*
+     * Edge states of many cubes at once, structure of arrays: row p holds the
+     * location of edge piece p for every lane, so a whole row is one run of
+     * bytes. Every location is a sticker index below 24 and a move or a frame
+     * change maps each one through the same 24-entry table, which the SIMD
+     * kernels do with two byte shuffles (pshufb) per 16 or 32 lanes.
+     *
+     * The kernel is picked at runtime from what the CPU supports (AVX2, SSSE3
+     * or plain C++); setKernel() forces a slower one for comparisons. Corners
+     * are left out, no cross depends on them.
+     */
+    class EdgeBatch {
+    public:
+	enum class Kernel {
+	    SCALAR,
+	    SSSE3,
+	    AVX2
+	};
+
+	//Constructor: n solved cubes
+	explicit EdgeBatch(std::size_t n);
+
+	std::size_t size() const { return n_; }
+
+	void set(std::size_t lane, const EdgeLocations& loc);
+	EdgeLocations get(std::size_t lane) const;
+
+	// the same move / moves on every lane
+	void applyMove(int move);
+	void applyMoves(const std::uint8_t* moves, std::size_t count);
+
+	// base-24 cross index of every lane in orientation o (cross::ORIENTATIONS order), size() entries
+	void crossIndices(int o, std::uint32_t* out) const;
+
+	// crossIndices() fed to the full table / the compact distance table
+	void solutions(int o, std::string_view* out) const;
+	void distances(int o, std::uint8_t* out) const;
+
+	Kernel kernel() const { return kernel_; }
+	void setKernel(Kernel k);	//clamped to what the CPU supports
+
+	static Kernel bestKernel();
+	static const char* kernelName(Kernel k);
+
+    private:
+	std::size_t n_;
+	std::size_t stride_;		//lanes per row, padded to a whole vector
+	std::vector<std::uint8_t> rows_;	//12 rows of stride_
+	Kernel kernel_;
+
+	const std::uint8_t* row_(int p) const { return rows_.data() + p * stride_; }
+	std::uint8_t* row_(int p) { return rows_.data() + p * stride_; }
+    };
+}
+
+#endif
@@ -0,0 +1,112 @@
+#include <deque>
+
+#include "F2LPairs.h"
+#include "CrossCoords.h"
+
+namespace {
+
+    constexpr int PAIRS = 24 * 24;
+
+    using PairTable = std::array<std::array<cross::PairState, PAIRS>, 4>;
+
+    // slot k holds corner piece 4 + k (DFR, DLF, DBL, DRB) and edge piece 4 + k (FR, FL, BL, BR)
+    std::uint8_t homeCorner(int slot) { return static_cast<std::uint8_t>(3 * (4 + slot)); }
+    std::uint8_t homeEdge(int slot) { return static_cast<std::uint8_t>(2 * (4 + slot)); }
+
+    const PairTable& pairTable(){
+	static const PairTable table = []{
+	    const cross::MoveTable& cornerMoves = cross::cornerMoveTable();
+	    const cross::MoveTable& edgeMoves = cross::edgeMoveTable();
+	    PairTable t;
+	    for(int slot = 0; slot < 4; slot++){
+		auto& cls = t[slot];
+		cls.fill(cross::PairState::SPLIT);
+		std::uint8_t c0 = homeCorner(slot);
+		std::uint8_t e0 = homeEdge(slot);
+
+		// CONNECTED: everywhere the solved pair goes when only faces holding both pieces turn
+		std::deque<int> queue{c0 * 24 + e0};
+		cls[c0 * 24 + e0] = cross::PairState::CONNECTED;
+		while(!queue.empty()){
+		    int c = queue.front() / 24;
+		    int e = queue.front() % 24;
+		    queue.pop_front();
+		    for(int m = 0; m < moves::COUNT; m++){
+			int nc = cornerMoves[c][m];
+			int ne = edgeMoves[e][m];
+			if(nc == c || ne == e) continue;
+			if(cls[nc * 24 + ne] == cross::PairState::CONNECTED) continue;
+			cls[nc * 24 + ne] = cross::PairState::CONNECTED;
+			queue.push_back(nc * 24 + ne);
+		    }
+		}
+
+		// INSERT: the solved pair taken back through every trigger (the set is closed under inverses)
+		const int sides[4] = {moves::R, moves::L, moves::F, moves::B};
+		for(int face : sides){
+		    for(int x : {face, moves::inverse(face)}){
+			int undo = moves::inverse(x);
+			for(int u = moves::U; u < moves::U + 3; u++){
+			    int c = c0;
+			    int e = e0;
+			    for(int m : {x, u, undo}){
+				c = cornerMoves[c][m];
+				e = edgeMoves[e][m];
+			    }
+			    cls[c * 24 + e] = cross::PairState::INSERT;
+			}
+		    }
+		}
+		cls[c0 * 24 + e0] = cross::PairState::SOLVED;
+	    }
+	    return t;
+	}();
+	return table;
+    }
+}
+
+namespace cross {
+
+    PairState classifyPair(int slot, std::uint8_t corner, std::uint8_t edge){
+	return pairTable()[slot][corner * 24 + edge];
+    }
+
+    PairStates classifyPairs(const EdgeLocations& edges, const CornerLocations& corners){
+	const PairTable& t = pairTable();
+	PairStates res;
+	for(int slot = 0; slot < 4; slot++) res[slot] = t[slot][corners[4 + slot] * 24 + edges[4 + slot]];
+	return res;
+    }
+
+    PairStates pairsAfter(const EdgeLocations& edges, const CornerLocations& corners, int o, const moves::Sequence& seq){
+	const OrientationTable& t = orientationTables()[o];
+	const MoveTable& edgeMoves = edgeMoveTable();
+	const MoveTable& cornerMoves = cornerMoveTable();
+	// only the slot pieces are followed, the cross is solved by construction
+	EdgeLocations e = orientEdges(edges, t);
+	CornerLocations c = orientCorners(corners, t);
+	for(int i = 0; i < seq.length; i++){
+	    int m = seq.moves[i];
+	    for(int p = 4; p < 8; p++){
+		e[p] = edgeMoves[e[p]][m];
+		c[p] = cornerMoves[c[p]][m];
+	    }
+	}
+	return classifyPairs(e, c);
+    }
+
+    int f2lScore(const PairStates& pairs){
+	int score = 0;
+	for(PairState s : pairs) score += static_cast<int>(s);
+	return score;
+    }
+
+    const char* pairStateName(PairState s){
+	switch(s){
+	    case PairState::SOLVED: return "solved";
+	    case PairState::INSERT: return "insert";
+	    case PairState::CONNECTED: return "connected";
+	    default: return "split";
+	}
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef F2L_PAIRS_H
+#define F2L_PAIRS_H
+
+#include <array>
+#include <cstdint>
+#include "CrossSymmetry.h"
+#include "Moves.h"
+
+namespace cross {
+
+    /*
+     * What one F2L pair looks like once the cross is done, worst to best:
+     *   SPLIT     - none of the below
+     *   CONNECTED - corner and edge already joined as a pair, anywhere
+     *   INSERT    - one trigger X U X' / X U' X' / X U2 X' (X a quarter turn
+     *               of R, L, F or B) solves it, no AUF needed
+     *   SOLVED    - both pieces home and oriented
+     */
+    enum class PairState : std::uint8_t {
+	SPLIT,
+	CONNECTED,
+	INSERT,
+	SOLVED
+    };
+
+    // FR, FL, BL, BR, the same order as XCrossSolver::Slot
+    using PairStates = std::array<PairState, 4>;
+
+    /*
+     * Table lookup on the slot's corner location (CORNER_POSITIONS index of
+     * its U/D sticker) and edge location (EDGE_POSITIONS index of its
+     * reference sticker), with the cross on D. The 4 x 24 x 24 table is
+     * built on first use from the move tables.
+     */
+    PairState classifyPair(int slot, std::uint8_t corner, std::uint8_t edge);
+
+    // all four pairs of a state already expressed in the frame with the cross on D
+    PairStates classifyPairs(const EdgeLocations& edges, const CornerLocations& corners);
+
+    // pairs left after solving orientation o's cross (cross::ORIENTATIONS) with `seq`, given in that frame
+    PairStates pairsAfter(const EdgeLocations& edges, const CornerLocations& corners, int o, const moves::Sequence& seq);
+
+    // 3 per solved pair, 2 per insert, 1 per connected one
+    int f2lScore(const PairStates& pairs);
+
+    const char* pairStateName(PairState s);
+}
+
+#endif
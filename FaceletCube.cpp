@@ -0,0 +1,251 @@
+#include <functional>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define FACELET_X86 1
+#endif
+
+#include "FaceletCube.h"
+#include "CrossConstants.hpp"
+#include "CubeManipulator.h"
+#include "Moves.h"
+
+namespace {
+
+    constexpr char kColours[6] = {'W', 'O', 'G', 'R', 'B', 'Y'};	//colour letter per probe digit
+
+    // ----- 64-byte shuffle: out[j] = src[p[j]] -----
+
+    void shuffleScalar(std::uint8_t* out, const std::uint8_t* src, const std::uint8_t* p){
+	std::uint8_t tmp[64];
+	for(int j = 0; j < 64; j++) tmp[j] = src[p[j]];
+	for(int j = 0; j < 64; j++) out[j] = tmp[j];
+    }
+
+#ifdef FACELET_X86
+
+    // pshufb only reaches within 16 bytes, so every output block ORs one lookup per source
+    // block; indices outside block s end up with bit 7 set (zero) after the saturating add
+    __attribute__((target("ssse3")))
+    void shuffleSsse3(std::uint8_t* out, const std::uint8_t* src, const std::uint8_t* p){
+	__m128i s[4];
+	for(int b = 0; b < 4; b++) s[b] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16 * b));
+	__m128i res[4];
+	for(int b = 0; b < 4; b++){
+	    __m128i idx = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * b));
+	    __m128i acc = _mm_setzero_si128();
+	    for(int k = 0; k < 4; k++){
+		__m128i ctl = _mm_adds_epu8(_mm_sub_epi8(idx, _mm_set1_epi8(static_cast<char>(16 * k))), _mm_set1_epi8(0x70));
+		acc = _mm_or_si128(acc, _mm_shuffle_epi8(s[k], ctl));
+	    }
+	    res[b] = acc;
+	}
+	for(int b = 0; b < 4; b++) _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16 * b), res[b]);
+    }
+
+    // same with each source block broadcast to both 128-bit halves
+    __attribute__((target("avx2")))
+    void shuffleAvx2(std::uint8_t* out, const std::uint8_t* src, const std::uint8_t* p){
+	__m256i s[4];
+	for(int b = 0; b < 4; b++) s[b] = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16 * b)));
+	__m256i res[2];
+	for(int h = 0; h < 2; h++){
+	    __m256i idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32 * h));
+	    __m256i acc = _mm256_setzero_si256();
+	    for(int k = 0; k < 4; k++){
+		__m256i ctl = _mm256_adds_epu8(_mm256_sub_epi8(idx, _mm256_set1_epi8(static_cast<char>(16 * k))), _mm256_set1_epi8(0x70));
+		acc = _mm256_or_si256(acc, _mm256_shuffle_epi8(s[k], ctl));
+	    }
+	    res[h] = acc;
+	}
+	for(int h = 0; h < 2; h++) _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 32 * h), res[h]);
+    }
+
+    // one vpermb over the whole block
+    __attribute__((target("avx512f,avx512bw,avx512vbmi")))
+    void shuffleVbmi(std::uint8_t* out, const std::uint8_t* src, const std::uint8_t* p){
+	__m512i idx = _mm512_loadu_si512(p);
+	__m512i s = _mm512_loadu_si512(src);
+	_mm512_storeu_si512(out, _mm512_maskz_permutexvar_epi8(~__mmask64(0), idx, s));
+    }
+
+#endif
+
+    using ShuffleFn = void (*)(std::uint8_t*, const std::uint8_t*, const std::uint8_t*);
+
+    struct Shuffle {
+	ShuffleFn fn = shuffleScalar;
+	const char* name = "scalar";
+
+	Shuffle(){
+#ifdef FACELET_X86
+	    if(__builtin_cpu_supports("avx512vbmi")){
+		fn = shuffleVbmi;
+		name = "avx512vbmi";
+	    } else if(__builtin_cpu_supports("avx2")){
+		fn = shuffleAvx2;
+		name = "avx2";
+	    } else if(__builtin_cpu_supports("ssse3")){
+		fn = shuffleSsse3;
+		name = "ssse3";
+	    }
+#endif
+	}
+    };
+
+    const Shuffle& shuffle(){
+	static const Shuffle s;
+	return s;
+    }
+
+    // ----- permutations, read off Cube -----
+
+    /*
+     * Facelet i is labelled with its index written in base 6, one digit per
+     * probe, as colours. After the operation, the digits found at j spell out
+     * where that facelet came from.
+     */
+    FaceletPerm probe(const std::function<void(Cube&)>& op){
+	FaceletPerm res = FaceletPerm::identity();
+	for(int j = 0; j < 54; j++) res.p[j] = 0;
+	int scale = 1;
+	for(int digit = 0; digit < 3; digit++, scale *= 6){
+	    Cube c;
+	    for(int i = 0; i < 54; i++){
+		c.setColorAtPosition(static_cast<Face>(i / 9), (i % 9) / 3, i % 3, kColours[(i / scale) % 6]);
+	    }
+	    op(c);
+	    for(int j = 0; j < 54; j++){
+		char col = c.getColorAtPosition(static_cast<Face>(j / 9), (j % 9) / 3, j % 3);
+		int d = 0;
+		while(kColours[d] != col) d++;
+		res.p[j] = static_cast<std::uint8_t>(res.p[j] + d * scale);
+	    }
+	}
+	return res;
+    }
+
+    enum Rotation { X, X_PRIME, X_2, Y, Y_PRIME, Y_2, Z, Z_PRIME, Z_2, ROTATIONS };
+
+    struct Perms {
+	std::array<FaceletPerm, moves::COUNT> move;
+	std::array<FaceletPerm, ROTATIONS> rotation;
+	std::array<std::array<FaceletPerm, 6>, 6> orient;	//[down][front] from the current frame, valid pairs only
+
+	Perms(){
+	    for(int m = 0; m < moves::COUNT; m++){
+		move[m] = probe([m](Cube& c){ CubeManipulator(c).applyMove(m); });
+	    }
+	    const std::array<void (Cube::*)(), ROTATIONS> rot = {
+		&Cube::rotate_x, &Cube::rotate_x_prime, &Cube::rotate_x_2,
+		&Cube::rotate_y, &Cube::rotate_y_prime, &Cube::rotate_y_2,
+		&Cube::rotate_z, &Cube::rotate_z_prime, &Cube::rotate_z_2};
+	    for(int r = 0; r < ROTATIONS; r++){
+		rotation[r] = probe([&rot, r](Cube& c){ (c.*rot[r])(); });
+	    }
+	    for(const auto& o : cross::ORIENTATIONS){
+		orient[static_cast<int>(o.first)][static_cast<int>(o.second)] = probe([&o](Cube& c){ c.orient(o.first, o.second); });
+	    }
+	}
+    };
+
+    const Perms& perms(){
+	static const Perms p;
+	return p;
+    }
+}
+
+FaceletPerm FaceletPerm::identity(){
+    FaceletPerm res;
+    for(int j = 0; j < 64; j++) res.p[j] = static_cast<std::uint8_t>(j);
+    return res;
+}
+
+FaceletPerm FaceletPerm::then(const FaceletPerm& next) const {
+    // b[j] = a[next[j]] = old[p[next[j]]], which is shuffling p itself by next
+    FaceletPerm res;
+    shuffle().fn(res.p.data(), p.data(), next.p.data());
+    return res;
+}
+
+FaceletCube::FaceletCube(){
+    f_.fill(0);
+    for(int i = 0; i < 54; i++) f_[i] = static_cast<std::uint8_t>(kColours[i / 9]);
+}
+
+FaceletCube::FaceletCube(const Cube& c){
+    f_.fill(0);
+    for(int i = 0; i < 54; i++){
+	f_[i] = static_cast<std::uint8_t>(c.getColorAtPosition(static_cast<Face>(i / 9), (i % 9) / 3, i % 3));
+    }
+}
+
+Cube FaceletCube::toCube() const {
+    Cube c;
+    for(int i = 0; i < 54; i++){
+	c.setColorAtPosition(static_cast<Face>(i / 9), (i % 9) / 3, i % 3, static_cast<char>(f_[i]));
+    }
+    return c;
+}
+
+void FaceletCube::apply(const FaceletPerm& perm){
+    shuffle().fn(f_.data(), f_.data(), perm.p.data());
+}
+
+void FaceletCube::applyMove(int move){
+    apply(perms().move[move]);
+}
+
+void FaceletCube::applyMoves(const std::uint8_t* moves, std::size_t n){
+    const Perms& t = perms();
+    for(std::size_t i = 0; i < n; i++) apply(t.move[moves[i]]);
+}
+
+void FaceletCube::orient(Face new_down, Face new_front){
+    // Cube compares against its orientation map; here the centres say where each face went
+    int down = -1;
+    int front = -1;
+    for(int f = 0; f < 6; f++){
+	char centre = static_cast<char>(f_[9 * f + 4]);
+	if(centre == kColours[static_cast<int>(new_down)]) down = f;
+	if(centre == kColours[static_cast<int>(new_front)]) front = f;
+    }
+    for(const auto& o : cross::ORIENTATIONS){
+	if(static_cast<int>(o.first) == down && static_cast<int>(o.second) == front){
+	    apply(perms().orient[down][front]);
+	    return;
+	}
+    }
+    std::cerr << "this orientation does not exist or was missed in implementation" << std::endl;
+}
+
+void FaceletCube::rotate_x(){ apply(perms().rotation[X]); }
+void FaceletCube::rotate_y(){ apply(perms().rotation[Y]); }
+void FaceletCube::rotate_z(){ apply(perms().rotation[Z]); }
+void FaceletCube::rotate_x_prime(){ apply(perms().rotation[X_PRIME]); }
+void FaceletCube::rotate_y_prime(){ apply(perms().rotation[Y_PRIME]); }
+void FaceletCube::rotate_z_prime(){ apply(perms().rotation[Z_PRIME]); }
+void FaceletCube::rotate_x_2(){ apply(perms().rotation[X_2]); }
+void FaceletCube::rotate_y_2(){ apply(perms().rotation[Y_2]); }
+void FaceletCube::rotate_z_2(){ apply(perms().rotation[Z_2]); }
+
+const FaceletPerm& FaceletCube::movePerm(int move){
+    return perms().move[move];
+}
+
+FaceletPerm FaceletCube::sequencePerm(const std::uint8_t* moves, std::size_t n){
+    const Perms& t = perms();
+    FaceletPerm res = FaceletPerm::identity();
+    for(std::size_t i = 0; i < n; i++) res = res.then(t.move[moves[i]]);
+    return res;
+}
+
+const char* FaceletCube::kernelName(){
+    return shuffle().name;
+}
+
+std::ostream& operator<<(std::ostream& out, const FaceletCube& c){
+    std::string net;
+    appendNet(net, c);
+    return out << net;
+}
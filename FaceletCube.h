@@ -0,0 +1,76 @@
+#ifndef FACELET_CUBE_H
+#define FACELET_CUBE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include "Cube.h"
+
+/*
+ * A permutation of the 54 facelets, padded to 64 bytes: after applying it,
+ * facelet j holds what facelet p[j] held before. Bytes 54..63 map to
+ * themselves.
+ */
+struct alignas(64) FaceletPerm {
+    std::array<std::uint8_t, 64> p;
+
+    // first this, then `then`, as one permutation
+    FaceletPerm then(const FaceletPerm& next) const;
+
+    static FaceletPerm identity();
+};
+
+/*
+ * Cube backend with the 54 facelets in one 64-byte block, indexed
+ * 9 * face + 3 * row + col in Face order, always as seen from the current
+ * orientation. Every face move, whole-cube rotation and orient() is a
+ * precomputed FaceletPerm, applied as one 64-byte shuffle (vpermb, or
+ * pshufb over 16-byte blocks, picked at runtime), so a whole move sequence
+ * can also be composed into a single permutation first.
+ *
+ * The permutations are read off Cube and CubeManipulator by probing, so
+ * getColorAtPosition() agrees with a Cube put through the same calls.
+ */
+class FaceletCube {
+private:
+    alignas(64) std::array<std::uint8_t, 64> f_;	//colour letters
+
+public:
+    //Constructor: solved
+    FaceletCube();
+    explicit FaceletCube(const Cube& c);
+
+    Cube toCube() const;
+
+    char getColorAtPosition(Face face, int row, int col) const {
+	return static_cast<char>(f_[9 * static_cast<int>(face) + 3 * row + col]);
+    }
+
+    void apply(const FaceletPerm& perm);
+    void applyMove(int move);	//moves::Move code
+    void applyMoves(const std::uint8_t* moves, std::size_t n);
+
+    //Adjust Orientation, same meaning as on Cube
+    void orient(Face new_down, Face new_front);
+    void rotate_x();
+    void rotate_y();
+    void rotate_z();
+    void rotate_x_prime();
+    void rotate_y_prime();
+    void rotate_z_prime();
+    void rotate_x_2();
+    void rotate_y_2();
+    void rotate_z_2();
+
+    bool operator==(const FaceletCube& o) const { return f_ == o.f_; }
+
+    static const FaceletPerm& movePerm(int move);
+    static FaceletPerm sequencePerm(const std::uint8_t* moves, std::size_t n);
+    static const char* kernelName();	//shuffle in use on this CPU
+};
+
+std::ostream& operator<<(std::ostream& out, const FaceletCube& c);
+
+#endif
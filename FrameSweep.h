@@ -0,0 +1,48 @@
+#ifndef FRAME_SWEEP_H
+#define FRAME_SWEEP_H
+
+#include <array>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "CrossSymmetry.h"
+
+namespace cross {
+
+    /*
+     * solve(i) for every i in [0, n), handed out one at a time through an
+     * atomic counter so a slow case doesn't hold up a whole share. Each i is
+     * solved exactly once, by whichever thread takes it.
+     */
+    template <typename Solve>
+    void forEachCase(int n, unsigned threads, Solve solve) {
+	std::atomic<int> nextCase{0};
+	auto work = [&](){
+	    for(int i = nextCase++; i < n; i = nextCase++) solve(i);
+	};
+	if(threads <= 1 || n <= 1){
+	    work();
+	    return;
+	}
+	std::vector<std::thread> pool;
+	for(unsigned t = 0; t < threads && static_cast<int>(t) < n; t++) pool.emplace_back(work);
+	for(std::thread& t : pool) t.join();
+    }
+
+    /*
+     * One search per entry in cross::ORIENTATIONS: solve(edges, corners) gets
+     * the state as seen from that frame (orientEdges / orientCorners), so
+     * whatever it returns is in that frame's move letters.
+     */
+    template <typename Result, typename Solve>
+    std::array<Result, 24> sweepFrames(const EdgeLocations& edges, const CornerLocations& corners, unsigned threads, Solve solve) {
+	const auto& tables = orientationTables();
+	std::array<Result, 24> res;
+	forEachCase(24, threads, [&](int o){
+	    res[o] = solve(orientEdges(edges, tables[o]), orientCorners(corners, tables[o]));
+	});
+	return res;
+    }
+}
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef IDA_SEARCH_H
+#define IDA_SEARCH_H
+
+#include "Moves.h"
+
+namespace ida {
+
+    /*
+     * Canonical sequences only: never two turns of the same face in a row,
+     * and opposite faces (which commute) only in increasing face order.
+     */
+    inline bool canFollow(int prev, int m) {
+	if(prev < 0) return true;
+	if(moves::face(m) == moves::face(prev)) return false;
+	return !(moves::axis(m) == moves::axis(prev) && moves::face(m) < moves::face(prev));
+    }
+
+    template <typename State, typename Heuristic, typename Apply>
+    bool dfs(const State& s, int g, int bound, int prev, Heuristic& h, Apply& apply, moves::Sequence& out) {
+	int hv = h(s);
+	if(hv == 0){
+	    out.length = static_cast<std::uint8_t>(g);
+	    return true;
+	}
+	if(g + hv > bound) return false;
+	for(int m = 0; m < moves::COUNT; m++){
+	    if(!canFollow(prev, m)) continue;
+	    out.moves[g] = static_cast<std::uint8_t>(m);
+	    if(dfs(apply(s, m), g + 1, bound, m, h, apply, out)) return true;
+	}
+	return false;
+    }
+
+    /*
+     * Iterative-deepening A*. h must be admissible and zero exactly at the
+     * goal. Returns false when nothing is found within maxDepth moves.
+     * The first solution in move-code order wins, so results are deterministic.
+     */
+    template <typename State, typename Heuristic, typename Apply>
+    bool solve(const State& start, int maxDepth, Heuristic h, Apply apply, moves::Sequence& out) {
+	if(maxDepth > static_cast<int>(out.moves.size())) maxDepth = static_cast<int>(out.moves.size());
+	for(int bound = h(start); bound <= maxDepth; bound++){
+	    if(dfs(start, 0, bound, -1, h, apply, out)) return true;
+	}
+	out.length = 0;
+	return false;
+    }
+}
+
+#endif
@@ -0,0 +1,125 @@
+#include <array>
+#include <iostream>
+
+#include "MoveParser.h"
+#include "Moves.h"
+
+namespace {
+    // face letter -> 3 * face in moves::Move order, -1 for anything else
+    constexpr std::array<std::int8_t, 256> FACE_CODE = []{
+	std::array<std::int8_t, 256> t{};
+	for(auto& v : t) v = -1;
+	t['R'] = moves::R;
+	t['L'] = moves::L;
+	t['U'] = moves::U;
+	t['D'] = moves::D;
+	t['F'] = moves::F;
+	t['B'] = moves::B;
+	return t;
+    }();
+}
+
+ParseResult parseMoves(std::string_view text, std::uint8_t* out, std::size_t capacity) noexcept {
+    ParseResult res;
+    std::size_t n = text.size();
+    for(std::size_t i = 0; i < n; i++){
+	unsigned char ch = static_cast<unsigned char>(text[i]);
+	if(ch == ' ' || ch == '\t' || ch == ',' || ch == '\r' || ch == '\n') continue;
+
+	int code = FACE_CODE[ch];
+	if(code < 0){
+	    res.error = ParseError::UNKNOWN_CHARACTER;
+	    res.errorPos = i;
+	    return res;
+	}
+	if(res.count == capacity){
+	    res.error = ParseError::TOO_MANY_MOVES;
+	    res.errorPos = i;
+	    return res;
+	}
+	if(i + 1 < n && text[i + 1] == '\''){
+	    code += 1;
+	    i++;
+	} else if(i + 1 < n && text[i + 1] == '2'){
+	    code += 2;
+	    i++;
+	    if(i + 1 < n && text[i + 1] == '\'') i++;
+	}
+	out[res.count++] = static_cast<std::uint8_t>(code);
+    }
+    return res;
+}
+
+std::string describeError(ParseError error, std::size_t pos, char c){
+    std::string msg = "column " + std::to_string(pos + 1) + ": ";
+    switch(error){
+	case ParseError::UNKNOWN_CHARACTER:
+	    msg += "unexpected '";
+	    msg += c;
+	    msg += "'";
+	    break;
+	case ParseError::TOO_MANY_MOVES:
+	    msg += "too many moves";
+	    break;
+	case ParseError::NONE:
+	    msg = "no error";
+	    break;
+    }
+    return msg;
+}
+
+std::string describeError(const ParseResult& res, std::string_view text){
+    char c = res.error == ParseError::UNKNOWN_CHARACTER ? text[res.errorPos] : ' ';
+    return describeError(res.error, res.errorPos, c);
+}
+
+std::string randomScramble(std::mt19937_64& rng, int length){
+    std::uniform_int_distribution<int> pick(0, moves::COUNT - 1);
+    std::string s;
+    int prev = -1;
+    for(int k = 0; k < length; k++){
+	int m;
+	do { m = pick(rng); } while(prev >= 0 && moves::face(m) == moves::face(prev));
+	if(!s.empty()) s += ' ';
+	s += moves::NAMES[m];
+	prev = m;
+    }
+    return s;
+}
+
+bool validMove(char move){
+    return move == 'R' || move == 'U' || move == 'D' || move == 'L' || move == 'F' || move == 'B';
+}
+
+std::vector<std::string> parseMoveString(const std::string& moves){
+    std::vector<std::string> parsedMoves;
+    int n = moves.length(); 
+    
+    for(int i = 0; i < n; i++){
+	if(!validMove(moves[i])) continue;
+	if(i + 1 < n && (moves[i + 1] == '\'' || moves[i + 1] == '2')){
+	    parsedMoves.push_back(moves.substr(i, 2)); 
+	    i++;
+	    continue;
+	}
+	parsedMoves.push_back(moves.substr(i, 1)); 
+    }
+    return parsedMoves;
+}
+
+void printMoveString(const std::vector<std::string>& moves){
+    int n = moves.size();
+    for(int i = 0; i < n; i++){
+	std::cout << moves[i] << " ";
+    }
+    std::cout << std::endl;
+}
+
+int numMoves(std::string_view sol){
+    int res = 0;
+    int n = sol.length();
+    for(int i = 0; i < n; i++){
+	if (validMove(sol[i])) ++res;
+    }
+    return res;
+}
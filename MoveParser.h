@@ -0,0 +1,42 @@
+#ifndef MOVE_PARSER_H
+#define MOVE_PARSER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum class ParseError : std::uint8_t { NONE, UNKNOWN_CHARACTER, TOO_MANY_MOVES };
+
+struct ParseResult {
+    std::size_t count = 0;			//move codes written
+    ParseError error = ParseError::NONE;
+    std::size_t errorPos = 0;			//offset into the text when error != NONE
+
+    bool ok() const { return error == ParseError::NONE; }
+};
+
+constexpr std::size_t MAX_SCRAMBLE_MOVES = 1024;	//buffer size callers use for one line
+
+/*
+ * Parses into moves::Move codes, one byte per move, without allocating.
+ * Face letters RLUDFB take an optional ' or 2 (2' counts as 2); spaces,
+ * tabs and commas separate moves. Parsing stops at the first other
+ * character or when `capacity` moves have been written.
+ */
+ParseResult parseMoves(std::string_view text, std::uint8_t* out, std::size_t capacity) noexcept;
+std::string describeError(const ParseResult& res, std::string_view text);
+// same message from its parts, when the text itself is gone (c is the offending character)
+std::string describeError(ParseError error, std::size_t pos, char c);
+
+// random face turns as text, never the same face twice in a row (benchmarks, load tests)
+std::string randomScramble(std::mt19937_64& rng, int length);
+
+bool validMove(char move);
+std::vector<std::string> parseMoveString(const std::string& moves);
+void printMoveString(const std::vector<std::string>& moves);
+int numMoves(std::string_view sol);
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef MOVES_H
+#define MOVES_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace moves {
+
+    /*
+     * Compact move codes, grouped by face in the same order
+     * CubeManipulator::applyMove checks them: code = 3 * face + turn,
+     * turn being 0 = clockwise, 1 = prime, 2 = double.
+     */
+    enum Move : std::uint8_t {
+	R, R_PRIME, R2,
+	L, L_PRIME, L2,
+	U, U_PRIME, U2,
+	D, D_PRIME, D2,
+	F, F_PRIME, F2,
+	B, B_PRIME, B2
+    };
+
+    constexpr int COUNT = 18;
+
+    constexpr std::array<std::string_view, COUNT> NAMES{{
+	"R", "R'", "R2", "L", "L'", "L2", "U", "U'", "U2",
+	"D", "D'", "D2", "F", "F'", "F2", "B", "B'", "B2"
+    }};
+
+    // face 0..5 in R L U D F B order, opposite faces share an axis
+    constexpr int face(int m) { return m / 3; }
+    constexpr int axis(int m) { return m / 6; }
+    constexpr int turn(int m) { return m % 3; }
+
+    // -1 when the name is not one of the 18 face turns
+    constexpr int fromName(std::string_view name) {
+	for(int m = 0; m < COUNT; m++){
+	    if(NAMES[m] == name) return m;
+	}
+	return -1;
+    }
+
+    constexpr int inverse(int m) {
+	return turn(m) == 2 ? m : (turn(m) == 0 ? m + 1 : m - 1);
+    }
+
+    // fixed-capacity move list so solvers can hand back solutions without allocating
+    struct Sequence {
+	std::array<std::uint8_t, 24> moves{};
+	std::uint8_t length = 0;
+    };
+
+    inline std::string toString(const Sequence& seq) {
+	std::string res;
+	for(int i = 0; i < seq.length; i++){
+	    if(i > 0) res += ' ';
+	    res += NAMES[seq.moves[i]];
+	}
+	return res;
+    }
+}
+
+#endif
@@ -0,0 +1,233 @@
+#include <array>
+
+#include "OutputFormat.h"
+#include "CrossConstants.hpp"
+#include "Cube.h"
+
+namespace {
+
+    // centre colours per orientation, read off a solved cube so they follow Cube's colour scheme
+    struct Colours {
+	std::array<char, 24> down;
+	std::array<char, 24> front;
+
+	Colours(){
+	    for(int o = 0; o < 24; o++){
+		Cube c;
+		c.orient(cross::ORIENTATIONS[o].first, cross::ORIENTATIONS[o].second);
+		down[o] = c.getColorAtPosition(Face::DOWN, 1, 1);
+		front[o] = c.getColorAtPosition(Face::FRONT, 1, 1);
+	    }
+	}
+    };
+
+    const Colours& colours(){
+	static const Colours table;
+	return table;
+    }
+
+    void appendJsonString(std::string& out, std::string_view s){
+	out += '"';
+	for(char ch : s){
+	    if(ch == '"' || ch == '\\'){
+		out += '\\';
+		out += ch;
+	    } else if(static_cast<unsigned char>(ch) < 0x20){
+		out += ' ';
+	    } else {
+		out += ch;
+	    }
+	}
+	out += '"';
+    }
+
+    // quoted only when it has to be
+    void appendCsvField(std::string& out, std::string_view s){
+	if(s.find_first_of(",\"\n") == std::string_view::npos){
+	    out += s;
+	    return;
+	}
+	out += '"';
+	for(char ch : s){
+	    if(ch == '"') out += '"';
+	    out += ch;
+	}
+	out += '"';
+    }
+
+    /*
+     * What "best" ranks by: cost when a metric was asked for (some row has
+     * a cost, or is COST_UNSOLVABLE), else length. Unsolvable rows have a
+     * negative key and are skipped.
+     */
+    bool weightedRows(const RowView* rows, std::size_t n){
+	for(std::size_t i = 0; i < n; i++){
+	    if(rows[i].cost != -1) return true;
+	}
+	return false;
+    }
+
+    int keyOf(const RowView& r, bool weighted){
+	return weighted ? r.cost : r.length;
+    }
+
+    // -1 when no row is solvable
+    int bestOf(const RowView* rows, std::size_t n, bool weighted){
+	int best = -1;
+	for(std::size_t i = 0; i < n; i++){
+	    int v = keyOf(rows[i], weighted);
+	    if(v >= 0 && (best < 0 || v < best)) best = v;
+	}
+	return best;
+    }
+}
+
+bool parseOutputFormat(std::string_view name, OutputFormat& fmt){
+    if(name == "text") fmt = OutputFormat::TEXT;
+    else if(name == "tsv") fmt = OutputFormat::TSV;
+    else if(name == "json") fmt = OutputFormat::JSON;
+    else if(name == "csv") fmt = OutputFormat::CSV;
+    else if(name == "compact") fmt = OutputFormat::COMPACT;
+    else return false;
+    return true;
+}
+
+char crossColour(int o){ return colours().down[o]; }
+char frontColour(int o){ return colours().front[o]; }
+
+const char* csvHeader(){
+    return "scramble,orientation,cross,front,moves,length,cost,error\n";
+}
+
+void appendRecord(std::string& out, OutputFormat fmt, std::string_view scramble, const RowView* rows, std::size_t n){
+    bool weighted = weightedRows(rows, n);
+    int best = bestOf(rows, n, weighted);
+    switch(fmt){
+	case OutputFormat::TEXT:
+	case OutputFormat::TSV:
+	    out += scramble;
+	    out += '\t';
+	    out += std::to_string(best);
+	    for(std::size_t i = 0; i < n; i++){
+		out += '\t';
+		out += rows[i].moves;
+	    }
+	    out += '\n';
+	    break;
+	case OutputFormat::JSON:
+	    out += "{\"scramble\":";
+	    appendJsonString(out, scramble);
+	    out += ",\"best\":";
+	    out += std::to_string(best);
+	    out += ",\"solutions\":[";
+	    for(std::size_t i = 0; i < n; i++){
+		const RowView& r = rows[i];
+		if(i > 0) out += ',';
+		out += "{\"orientation\":";
+		out += std::to_string(r.orientation);
+		out += ",\"cross\":\"";
+		out += crossColour(r.orientation);
+		out += "\",\"front\":\"";
+		out += frontColour(r.orientation);
+		out += "\",\"moves\":\"";
+		out += r.moves;
+		out += "\",\"length\":";
+		out += std::to_string(r.length);
+		if(r.cost >= 0){
+		    out += ",\"cost\":";
+		    out += std::to_string(r.cost);
+		} else if(r.cost == COST_UNSOLVABLE){
+		    out += ",\"cost\":null,\"unsolvable\":true";
+		}
+		out += '}';
+	    }
+	    out += "]}\n";
+	    break;
+	case OutputFormat::CSV:
+	    for(std::size_t i = 0; i < n; i++){
+		const RowView& r = rows[i];
+		appendCsvField(out, scramble);
+		out += ',';
+		out += std::to_string(r.orientation);
+		out += ',';
+		out += crossColour(r.orientation);
+		out += ',';
+		out += frontColour(r.orientation);
+		out += ',';
+		out += r.moves;
+		out += ',';
+		out += std::to_string(r.length);
+		out += ',';
+		if(r.cost >= 0) out += std::to_string(r.cost);
+		out += ',';
+		if(r.cost == COST_UNSOLVABLE) out += "unsolvable";
+		out += '\n';
+	    }
+	    break;
+	case OutputFormat::COMPACT:
+	    out += scramble;
+	    out += ';';
+	    out += std::to_string(best);
+	    for(std::size_t i = 0; i < n; i++){
+		const RowView& r = rows[i];
+		if(best < 0 || keyOf(r, weighted) != best) continue;
+		out += ';';
+		out += crossColour(r.orientation);
+		out += frontColour(r.orientation);
+		out += '=';
+		out += r.moves;
+	    }
+	    out += '\n';
+	    break;
+    }
+}
+
+void appendError(std::string& out, OutputFormat fmt, std::string_view scramble, std::string_view message){
+    switch(fmt){
+	case OutputFormat::TEXT:
+	case OutputFormat::TSV:
+	    out += scramble;
+	    out += "\terror\t";
+	    out += message;
+	    break;
+	case OutputFormat::JSON:
+	    out += "{\"scramble\":";
+	    appendJsonString(out, scramble);
+	    out += ",\"error\":";
+	    appendJsonString(out, message);
+	    out += '}';
+	    break;
+	case OutputFormat::CSV:
+	    appendCsvField(out, scramble);
+	    out += ",,,,,,,";
+	    appendCsvField(out, message);
+	    break;
+	case OutputFormat::COMPACT:
+	    out += scramble;
+	    out += ";error;";
+	    out += message;
+	    break;
+    }
+    out += '\n';
+}
+
+BufferedWriter::BufferedWriter(std::ostream& out, std::size_t capacity) : out_(out), capacity_(capacity) {
+    buf_.reserve(capacity + capacity / 4);
+}
+
+BufferedWriter::~BufferedWriter(){
+    flush();
+}
+
+void BufferedWriter::write(std::string_view s){
+    buf_ += s;
+    commit();
+}
+
+void BufferedWriter::flush(){
+    if(!buf_.empty()){
+	out_.write(buf_.data(), static_cast<std::streamsize>(buf_.size()));
+	buf_.clear();
+    }
+    out_.flush();
+}
@@ -0,0 +1,79 @@
+#ifndef OUTPUT_FORMAT_H
+#define OUTPUT_FORMAT_H
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+/*
+ * Machine-readable records for one solved scramble, appended to a string so
+ * callers batch as many as they like into one write:
+ *
+ *   tsv      scramble \t best \t 24 solutions in orientation order
+ *   json     {"scramble":"...","best":5,"solutions":[{"orientation":7,"cross":"Y","front":"G","moves":"...","length":5},...]}
+ *   csv      one row per orientation under csvHeader()
+ *   compact  scramble;best;YG=R U F';WR=...   (only the orientations at best)
+ *
+ * An orientation the metric's moves can't solve has no moves, "cost":null
+ * and "unsolvable":true in json, and "unsolvable" in the csv error column.
+ *
+ * text is the human block format (SolutionPrinter), it has no record form.
+ */
+enum class OutputFormat {
+    TEXT,
+    TSV,
+    JSON,
+    CSV,
+    COMPACT
+};
+
+bool parseOutputFormat(std::string_view name, OutputFormat& fmt);
+
+// one orientation of a record; rows can be in any order
+struct RowView {
+    std::string_view moves;
+    int orientation;
+    int length;
+    int cost;	//-1 when no metric was asked for, "best" is then the shortest length
+};
+
+// RowView / SolutionRow cost of an orientation the allowed moves can't solve, it never counts as best
+constexpr int COST_UNSOLVABLE = -2;
+
+// down (cross) and front centre colour letters of orientation o
+char crossColour(int o);
+char frontColour(int o);
+
+// column names for CSV, with the newline
+const char* csvHeader();
+
+void appendRecord(std::string& out, OutputFormat fmt, std::string_view scramble, const RowView* rows, std::size_t n);
+void appendError(std::string& out, OutputFormat fmt, std::string_view scramble, std::string_view message);
+
+/*
+ * Collects output and hands it to the stream in large writes, so nothing is
+ * flushed per line. Flushes when full, on flush() and when destroyed.
+ */
+class BufferedWriter {
+private:
+    std::ostream& out_;
+    std::string buf_;
+    std::size_t capacity_;
+
+public:
+    //Constructor
+    explicit BufferedWriter(std::ostream& out, std::size_t capacity = 1 << 16);
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+    ~BufferedWriter();
+
+    // append straight into the buffer, then call commit()
+    std::string& buffer() { return buf_; }
+    void commit() { if(buf_.size() >= capacity_) flush(); }
+
+    void write(std::string_view s);
+    void flush();
+};
+
+#endif
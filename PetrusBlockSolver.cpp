@@ -0,0 +1,153 @@
+#include "PetrusBlockSolver.h"
+#include "CrossCoords.h"
+#include "DistanceTable.h"
+#include "FrameSweep.h"
+#include "IdaSearch.h"
+
+namespace {
+
+    // edge and corner pieces, numbered by their solved slot
+    constexpr int DF = 8;
+    constexpr int DL = 9;
+    constexpr int DB = 10;
+    constexpr int FL = 5;
+    constexpr int BL = 6;
+    constexpr int DLF = 5;
+    constexpr int DBL = 6;
+
+    constexpr std::size_t STATES = 24 * 24 * 24 * 24;
+
+    // optimal 2x2x3 blocks stay around 13 moves
+    constexpr int MAX_DEPTH = 20;
+
+    // faces in moves::face order
+    constexpr unsigned R = 1, L = 2, U = 4, D = 8, F = 16, B = 32;
+    constexpr std::array<unsigned, 8> CORNER_FACES{{U | R | F, U | F | L, U | L | B, U | B | R, D | F | R, D | L | F, D | B | L, D | R | B}};
+    constexpr std::array<unsigned, 12> EDGE_FACES{{U | F, U | L, U | B, U | R, F | R, F | L, B | L, B | R, D | F, D | L, D | B, D | R}};
+
+    struct Frames {
+	std::array<int, 8> corner;	//an orientation whose DBL is this corner
+	std::array<int, 12> edge;	//an orientation whose DL is this edge
+	std::array<std::array<int, 3>, 8> extensions;
+    };
+
+    const Frames& frames(){
+	static const Frames f = []{
+	    const auto& tables = cross::orientationTables();
+	    Frames res;
+	    res.corner.fill(-1);
+	    res.edge.fill(-1);
+	    for(int o = 0; o < 24; o++){
+		const std::array<std::uint8_t, 6>& face = tables[o].moveFace;
+		unsigned down = 1u << face[3], back = 1u << face[5], left = 1u << face[1];
+		for(int c = 0; c < 8; c++){
+		    if(res.corner[c] < 0 && CORNER_FACES[c] == (down | back | left)) res.corner[c] = o;
+		}
+		for(int e = 0; e < 12; e++){
+		    if(res.edge[e] < 0 && EDGE_FACES[e] == (down | left)) res.edge[e] = o;
+		}
+	    }
+	    for(int c = 0; c < 8; c++){
+		int k = 0;
+		for(int e = 0; e < 12; e++){
+		    if((EDGE_FACES[e] & CORNER_FACES[c]) == EDGE_FACES[e]) res.extensions[c][k++] = e;
+		}
+	    }
+	    return res;
+	}();
+	return f;
+    }
+
+    struct State {
+	std::array<std::uint8_t, 5> edges;	//DL, DB, BL, DF, FL
+	std::array<std::uint8_t, 2> corners;	//DBL, DLF
+    };
+
+    std::size_t index(std::uint8_t a, std::uint8_t b, std::uint8_t c, std::uint8_t corner){
+	return a + 24 * (b + 24 * (c + 24 * static_cast<std::size_t>(corner)));
+    }
+
+    std::vector<std::uint8_t> buildTable(int b, int c, int corner, unsigned threads){
+	const cross::MoveTable& edgeMoves = cross::edgeMoveTable();
+	const cross::MoveTable& cornerMoves = cross::cornerMoveTable();
+	auto next = [&](std::size_t idx, int m){
+	    return index(edgeMoves[idx % 24][m], edgeMoves[(idx / 24) % 24][m], edgeMoves[(idx / 576) % 24][m], cornerMoves[idx / 13824][m]);
+	};
+	std::size_t goal = index(2 * DL, static_cast<std::uint8_t>(2 * b), static_cast<std::uint8_t>(2 * c), static_cast<std::uint8_t>(3 * corner));
+	return dist::bfs(STATES, {goal}, moves::COUNT, next, threads);
+    }
+
+    State startState(const cross::EdgeLocations& edges, const cross::CornerLocations& corners){
+	return State{{edges[DL], edges[DB], edges[BL], edges[DF], edges[FL]}, {corners[DBL], corners[DLF]}};
+    }
+
+    State applyMove(const State& s, int m){
+	const cross::MoveTable& edgeMoves = cross::edgeMoveTable();
+	const cross::MoveTable& cornerMoves = cross::cornerMoveTable();
+	State t;
+	for(int k = 0; k < 5; k++) t.edges[k] = edgeMoves[s.edges[k]][m];
+	for(int k = 0; k < 2; k++) t.corners[k] = cornerMoves[s.corners[k]][m];
+	return t;
+    }
+
+    // frame moves back to moves of the unrotated cube
+    moves::Sequence unrotate(moves::Sequence seq, const cross::OrientationTable& t){
+	for(int i = 0; i < seq.length; i++) seq.moves[i] = static_cast<std::uint8_t>(cross::physicalMove(seq.moves[i], t));
+	return seq;
+    }
+}
+
+PetrusBlockSolver::PetrusBlockSolver(const std::string& tableDir, unsigned threads) {
+    backBlock_ = dist::loadOrBuild(tableDir, "block-dbl", STATES, [&]{ return buildTable(DB, BL, DBL, threads); });
+    frontBlock_ = dist::loadOrBuild(tableDir, "block-dlf", STATES, [&]{ return buildTable(DF, FL, DLF, threads); });
+    frames();
+}
+
+const std::array<int, 3>& PetrusBlockSolver::extensions(int corner){
+    return frames().extensions[corner];
+}
+
+moves::Sequence PetrusBlockSolver::solveBlock(const cross::EdgeLocations& edges, const cross::CornerLocations& corners) const {
+    const std::uint8_t* back = backBlock_.data();
+    auto h = [&](const State& s){
+	return static_cast<int>(back[index(s.edges[0], s.edges[1], s.edges[2], s.corners[0])]);
+    };
+    moves::Sequence sol;
+    ida::solve(startState(edges, corners), MAX_DEPTH, h, applyMove, sol);
+    return sol;
+}
+
+moves::Sequence PetrusBlockSolver::solveExtended(const cross::EdgeLocations& edges, const cross::CornerLocations& corners) const {
+    const std::uint8_t* back = backBlock_.data();
+    const std::uint8_t* front = frontBlock_.data();
+    auto h = [&](const State& s){
+	int a = back[index(s.edges[0], s.edges[1], s.edges[2], s.corners[0])];
+	int b = front[index(s.edges[0], s.edges[3], s.edges[4], s.corners[1])];
+	return a > b ? a : b;
+    };
+    moves::Sequence sol;
+    ida::solve(startState(edges, corners), MAX_DEPTH, h, applyMove, sol);
+    return sol;
+}
+
+PetrusBlockSolver::Blocks PetrusBlockSolver::solveAll(const cross::EdgeLocations& edges, const cross::CornerLocations& corners, unsigned threads) const {
+    const auto& tables = cross::orientationTables();
+    const Frames& f = frames();
+
+    // the 2x2x3s go first, they are the long searches
+    Blocks res;
+    cross::forEachCase(20, threads, [&](int i){
+	if(i < 12){
+	    const cross::OrientationTable& t = tables[f.edge[i]];
+	    res.extended[i] = unrotate(solveExtended(cross::orientEdges(edges, t), cross::orientCorners(corners, t)), t);
+	} else {
+	    const cross::OrientationTable& t = tables[f.corner[i - 12]];
+	    res.block[i - 12] = unrotate(solveBlock(cross::orientEdges(edges, t), cross::orientCorners(corners, t)), t);
+	}
+    });
+    return res;
+}
+
+PetrusBlockSolver::Blocks PetrusBlockSolver::solveAll(const CubieCube& cc, unsigned threads) const {
+    return solveAll(cc.edgeLocations(), cc.cornerLocations(), threads);
+}
@@ -0,0 +1,50 @@
+#ifndef PETRUS_BLOCK_SOLVER_H
+#define PETRUS_BLOCK_SOLVER_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "CrossSymmetry.h"
+#include "CubieCube.h"
+#include "Moves.h"
+
+/*
+ * Optimal Petrus / FreeFOP 2x2x2 blocks around each of the 8 corners and
+ * 2x2x3 blocks along each of the 12 edges, by IDA*.
+ *
+ * Every block is searched in the frame of an orientation that puts it at
+ * the back-down-left (the 2x2x2 around DBL, the 2x2x3 along DL), then the
+ * moves are named for the unrotated cube again, so no rotation is needed.
+ *
+ * A 2x2x2 is one corner plus three edges: 24^4 states, small enough for an
+ * exact distance table. Two of them, around DBL and around DLF, make up the
+ * DL 2x2x3, and the larger of the two distances prunes that search.
+ */
+class PetrusBlockSolver {
+public:
+    struct Blocks {
+	std::array<moves::Sequence, 8> block;	//2x2x2 around URF, UFL, ULB, UBR, DFR, DLF, DBL, DRB
+	std::array<moves::Sequence, 12> extended;	//2x2x3 along UF, UL, UB, UR, FR, FL, BL, BR, DF, DL, DB, DR
+    };
+
+    //Constructor: loads the pruning tables from tableDir, building (and saving) them when missing
+    explicit PetrusBlockSolver(const std::string& tableDir = "", unsigned threads = 1);
+
+    //Every 2x2x2 and 2x2x3, the 20 searches spread over `threads`
+    Blocks solveAll(const CubieCube& cc, unsigned threads = 1) const;
+    Blocks solveAll(const cross::EdgeLocations& edges, const cross::CornerLocations& corners, unsigned threads = 1) const;
+
+    //DBL 2x2x2 / DL 2x2x3 of a state already expressed in the frame to solve in
+    moves::Sequence solveBlock(const cross::EdgeLocations& edges, const cross::CornerLocations& corners) const;
+    moves::Sequence solveExtended(const cross::EdgeLocations& edges, const cross::CornerLocations& corners) const;
+
+    //The three edges (Blocks::extended index) whose 2x2x3 holds the 2x2x2 around `corner`
+    static const std::array<int, 3>& extensions(int corner);
+
+private:
+    std::vector<std::uint8_t> backBlock_;	//[DL][DB][BL][DBL corner]
+    std::vector<std::uint8_t> frontBlock_;	//[DL][DF][FL][DLF corner]
+};
+
+#endif
@@ -0,0 +1,78 @@
+#include "RouxBlockSolver.h"
+#include "CrossCoords.h"
+#include "DistanceTable.h"
+#include "FrameSweep.h"
+#include "IdaSearch.h"
+
+namespace {
+
+    // pieces of the left block, numbered as in EDGE_POSITIONS / CORNER_POSITIONS slots
+    constexpr int DL = 9;
+    constexpr int FL = 5;
+    constexpr int BL = 6;
+    constexpr int DLF = 5;
+    constexpr int DBL = 6;
+
+    constexpr std::size_t STATES = 24 * 24 * 24 * 24;
+
+    // optimal first blocks stay around 10 moves
+    constexpr int MAX_DEPTH = 16;
+
+    struct State {
+	std::array<std::uint8_t, 3> edges;	//DL, FL, BL
+	std::array<std::uint8_t, 2> corners;	//DLF, DBL
+    };
+
+    std::size_t index(const std::array<std::uint8_t, 3>& e, std::uint8_t corner){
+	return e[0] + 24 * (e[1] + 24 * (e[2] + 24 * static_cast<std::size_t>(corner)));
+    }
+
+    std::vector<std::uint8_t> buildTable(int corner, unsigned threads){
+	const cross::MoveTable& edgeMoves = cross::edgeMoveTable();
+	const cross::MoveTable& cornerMoves = cross::cornerMoveTable();
+	auto next = [&](std::size_t idx, int m){
+	    std::array<std::uint8_t, 3> e;
+	    for(int k = 0; k < 3; k++, idx /= 24) e[k] = edgeMoves[idx % 24][m];
+	    return index(e, cornerMoves[idx][m]);
+	};
+	std::array<std::uint8_t, 3> goal{{2 * DL, 2 * FL, 2 * BL}};
+	return dist::bfs(STATES, {index(goal, static_cast<std::uint8_t>(3 * corner))}, moves::COUNT, next, threads);
+    }
+}
+
+RouxBlockSolver::RouxBlockSolver(const std::string& tableDir, unsigned threads) {
+    edgesFront_ = dist::loadOrBuild(tableDir, "roux-block-dlf", STATES, [&]{ return buildTable(DLF, threads); });
+    edgesBack_ = dist::loadOrBuild(tableDir, "roux-block-dbl", STATES, [&]{ return buildTable(DBL, threads); });
+}
+
+moves::Sequence RouxBlockSolver::solve(const cross::EdgeLocations& edges, const cross::CornerLocations& corners) const {
+    const cross::MoveTable& edgeMoves = cross::edgeMoveTable();
+    const cross::MoveTable& cornerMoves = cross::cornerMoveTable();
+    const std::uint8_t* front = edgesFront_.data();
+    const std::uint8_t* back = edgesBack_.data();
+
+    auto h = [&](const State& s){
+	int a = front[index(s.edges, s.corners[0])];
+	int b = back[index(s.edges, s.corners[1])];
+	return a > b ? a : b;
+    };
+    auto apply = [&](const State& s, int m){
+	return State{{edgeMoves[s.edges[0]][m], edgeMoves[s.edges[1]][m], edgeMoves[s.edges[2]][m]},
+		     {cornerMoves[s.corners[0]][m], cornerMoves[s.corners[1]][m]}};
+    };
+
+    State start{{edges[DL], edges[FL], edges[BL]}, {corners[DLF], corners[DBL]}};
+    moves::Sequence sol;
+    ida::solve(start, MAX_DEPTH, h, apply, sol);
+    return sol;
+}
+
+std::array<moves::Sequence, 24> RouxBlockSolver::solveAll(const cross::EdgeLocations& edges, const cross::CornerLocations& corners, unsigned threads) const {
+    return cross::sweepFrames<moves::Sequence>(edges, corners, threads, [&](const cross::EdgeLocations& e, const cross::CornerLocations& c){
+	return solve(e, c);
+    });
+}
+
+std::array<moves::Sequence, 24> RouxBlockSolver::solveAll(const CubieCube& cc, unsigned threads) const {
+    return solveAll(cc.edgeLocations(), cc.cornerLocations(), threads);
+}
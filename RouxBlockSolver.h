@@ -0,0 +1,43 @@
+#ifndef ROUX_BLOCK_SOLVER_H
+#define ROUX_BLOCK_SOLVER_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "CrossSymmetry.h"
+#include "CubieCube.h"
+#include "Moves.h"
+
+/*
+ * Optimal Roux first block (the 1x2x3 on the left: DL, FL and BL edges,
+ * DLF and DBL corners) by IDA*.
+ *
+ * Every first block is the left block of exactly one entry in
+ * cross::ORIENTATIONS (its Down colour at the bottom, Front picking the
+ * side), so the 24 searches of a sweep cover every block location and
+ * orientation on the cube. Each search runs in that orientation's frame
+ * after cross::orientEdges / orientCorners, so moves come out in it.
+ *
+ * The state is the sticker location of the five pieces. It is pruned with
+ * two tables over (three edges x one corner), 24^4 bytes each, one per
+ * corner.
+ */
+class RouxBlockSolver {
+public:
+    //Constructor: loads the pruning tables from tableDir, building (and saving) them when missing
+    explicit RouxBlockSolver(const std::string& tableDir = "", unsigned threads = 1);
+
+    //One entry per cross::ORIENTATIONS, the 24 searches spread over `threads`
+    std::array<moves::Sequence, 24> solveAll(const CubieCube& cc, unsigned threads = 1) const;
+    std::array<moves::Sequence, 24> solveAll(const cross::EdgeLocations& edges, const cross::CornerLocations& corners, unsigned threads = 1) const;
+
+    //Left block of a state already expressed in the frame to solve in
+    moves::Sequence solve(const cross::EdgeLocations& edges, const cross::CornerLocations& corners) const;
+
+private:
+    std::vector<std::uint8_t> edgesFront_;	//[DL][FL][BL][DLF corner]
+    std::vector<std::uint8_t> edgesBack_;	//[DL][FL][BL][DBL corner]
+};
+
+#endif
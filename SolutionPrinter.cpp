@@ -0,0 +1,145 @@
+#include <array>
+
+#include "SolutionPrinter.h"
+#include "CrossConstants.hpp"
+#include "CubeManipulator.h"
+#include "CubieCube.h"
+#include "FaceletCube.h"
+#include "MoveParser.h"
+
+namespace {
+    // centre colour letter to its name
+    std::string colourName(char c){
+	if(c == 'W') return "White";
+	if(c == 'R') return "Red";
+	if(c == 'B') return "Blue";
+	if(c == 'G') return "Green";
+	if(c == 'O') return "Orange";
+	if(c == 'Y') return "Yellow";
+	return "";
+    }
+}
+
+std::string getOrientation(Cube c){
+    std::string front = colourName(c.getColorAtPosition(Face::FRONT, 1, 1));
+    std::string down = colourName(c.getColorAtPosition(Face::DOWN, 1, 1));
+    return down + " Cross, " + front + " in front";
+}
+
+const std::string& orientationLabel(int o){
+    static const std::array<std::string, 24> labels = []{
+	std::array<std::string, 24> t;
+	for(int i = 0; i < 24; i++){
+	    Cube c;
+	    c.orient(cross::ORIENTATIONS[i].first, cross::ORIENTATIONS[i].second);
+	    t[i] = getOrientation(c);
+	}
+	return t;
+    }();
+    return labels[o];
+}
+
+const std::string& blockLabel(int o){
+    static const std::array<std::string, 24> labels = []{
+	std::array<std::string, 24> t;
+	for(int i = 0; i < 24; i++){
+	    Cube c;
+	    c.orient(cross::ORIENTATIONS[i].first, cross::ORIENTATIONS[i].second);
+	    t[i] = colourName(c.getColorAtPosition(Face::LEFT, 1, 1)) + " Block, " + colourName(c.getColorAtPosition(Face::DOWN, 1, 1)) + " on bottom";
+	}
+	return t;
+    }();
+    return labels[o];
+}
+
+namespace {
+    // left-aligned in a column of width w, like std::setw with std::left
+    void appendPadded(std::string& out, std::string_view s, std::size_t w){
+	out += s;
+	if(s.size() < w) out.append(w - s.size(), ' ');
+    }
+}
+
+void printSolutions(BufferedWriter& out, const std::vector<SolutionRow>& sol, const Cube& c, const Alternatives* alts, bool net, std::size_t altLimit){
+    FaceletCube scrambled(c);
+    const char* slotNames[4] = {"FR", "FL", "BL", "BR"};
+    // pieces for scoring alternatives, only read when rows carry an F2L score
+    cross::EdgeLocations edges{};
+    cross::CornerLocations corners{};
+    bool scored = false;
+    if(alts && !sol.empty() && sol.front().f2l >= 0){
+	if(std::optional<CubieCube> pieces = CubieCube::fromCube(c)){
+	    edges = pieces->edgeLocations();
+	    corners = pieces->cornerLocations();
+	    scored = true;
+	}
+    }
+    for(const SolutionRow& row : sol){
+	int o = row.orientation;
+	std::string& buf = out.buffer();
+	buf += "Solution: ";
+	appendPadded(buf, row.moves, 20);
+	appendPadded(buf, row.label, 45);
+	buf += "Move Count: ";
+	appendPadded(buf, std::to_string(row.length), 10);
+	if(row.cost >= 0){
+	    buf += "Cost: ";
+	    buf += std::to_string(row.cost);
+	} else if(row.cost == COST_UNSOLVABLE){
+	    buf += "Cost: unsolvable";
+	}
+	buf += '\n';
+	if(row.f2l >= 0){
+	    buf += "F2L Pairs: ";
+	    for(int k = 0; k < 4; k++){
+		buf += k > 0 ? ", " : "";
+		buf += slotNames[k];
+		buf += ' ';
+		buf += cross::pairStateName(row.pairs[k]);
+	    }
+	    buf += " (score ";
+	    buf += std::to_string(row.f2l);
+	    buf += ")\n";
+	}
+	if(alts){
+	    const std::vector<moves::Sequence>& list = (*alts)[o];
+	    bool cut = list.size() > altLimit;
+	    std::size_t shown = cut ? altLimit : list.size();
+	    buf += "All Solutions (";
+	    if(cut) buf += "first ";
+	    buf += std::to_string(shown);
+	    if(cut) buf += ", stopped at --limit";
+	    buf += "): \n";
+	    for(std::size_t k = 0; k < shown; k++){
+		const moves::Sequence& seq = list[k];
+		buf += "    ";
+		appendPadded(buf, moves::toString(seq), 30);
+		buf += std::to_string(seq.length);
+		if(scored && row.f2l >= 0){
+		    buf += "    F2L ";
+		    buf += std::to_string(cross::f2lScore(cross::pairsAfter(edges, corners, o, seq)));
+		}
+		buf += '\n';
+	    }
+	}
+	if(net){
+	    // only the net needs the cube turned and the solution applied
+	    FaceletCube temp = scrambled;
+	    temp.orient(cross::ORIENTATIONS[o].first, cross::ORIENTATIONS[o].second);
+	    std::uint8_t moves[MAX_SCRAMBLE_MOVES];
+	    ParseResult parsed = parseMoves(row.moves, moves, MAX_SCRAMBLE_MOVES);
+	    temp.applyMoves(moves, parsed.count);
+	    buf += "After Cross Solution: \n";
+	    appendNet(buf, temp);
+	    buf += '\n';
+	}
+	out.commit();
+    }
+}
+
+void appendRows(std::string& out, OutputFormat fmt, std::string_view scramble, const std::vector<SolutionRow>& sol){
+    std::vector<RowView> rows;
+    rows.reserve(sol.size());
+    for(const SolutionRow& r : sol) rows.push_back({r.moves, r.orientation, r.length, r.cost});
+    appendRecord(out, fmt, scramble, rows.data(), rows.size());
+}
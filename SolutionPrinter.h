@@ -0,0 +1,44 @@
+#ifndef SOLUTION_PRINTER_H
+#define SOLUTION_PRINTER_H
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Cube.h"
+#include "F2LPairs.h"
+#include "Moves.h"
+#include "OutputFormat.h"
+
+using Alternatives = std::array<std::vector<moves::Sequence>, 24>;
+
+// one printed orientation; rows can be reordered, orientation says which frame it is
+struct SolutionRow {
+    std::string moves;
+    std::string label;
+    int orientation;
+    int cost;	//-1 when no metric was asked for, COST_UNSOLVABLE when the metric's moves can't solve it
+    int length;
+    int f2l = -1;	//cross::f2lScore of what the solution leaves, -1 when not asked for
+    cross::PairStates pairs{};
+};
+
+// "White Cross, Red in front" for the cube's current down and front centers
+std::string getOrientation(Cube c);
+
+// the same label for orientation o, from a table (centres never move under face turns)
+const std::string& orientationLabel(int o);
+
+// "Orange Block, White on bottom": the Roux first block orientation o builds on its left
+const std::string& blockLabel(int o);
+
+// one block per row: the solution, its move count (and cost), F2L pairs, alternatives and, with net, the cube after solving
+// alternatives longer than altLimit are printed cut to it, and the header says so
+void printSolutions(BufferedWriter& out, const std::vector<SolutionRow>& sol, const Cube& c, const Alternatives* alts = nullptr, bool net = true, std::size_t altLimit = SIZE_MAX);
+
+// the rows as one machine-readable record
+void appendRows(std::string& out, OutputFormat fmt, std::string_view scramble, const std::vector<SolutionRow>& sol);
+
+#endif
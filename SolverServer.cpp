@@ -0,0 +1,362 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "SolverServer.h"
+#include "CrossCache.h"
+#include "CrossCoords.h"
+#include "CrossMetric.h"
+#include "CrossSweep.h"
+#include "MoveParser.h"
+#include "Moves.h"
+
+namespace {
+
+    // longer lines are answered with an error and skipped
+    constexpr std::size_t kMaxLine = 4096;
+
+    void appendEscaped(std::string& out, std::string_view s){
+	for(char ch : s){
+	    if(ch == '"' || ch == '\\'){
+		out += '\\';
+		out += ch;
+	    } else if(static_cast<unsigned char>(ch) < 0x20){
+		out += ' ';
+	    } else {
+		out += ch;
+	    }
+	}
+    }
+
+    void error(std::string& out, std::string_view msg){
+	out += "{\"ok\":false,\"error\":\"";
+	appendEscaped(out, msg);
+	out += "\"}";
+    }
+
+    std::string_view trim(std::string_view s){
+	while(!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+	while(!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) s.remove_suffix(1);
+	return s;
+    }
+
+    template <typename T>
+    void appendList(std::string& out, const char* key, const T& values){
+	out += ",\"";
+	out += key;
+	out += "\":[";
+	for(std::size_t i = 0; i < values.size(); i++){
+	    if(i > 0) out += ',';
+	    out += std::to_string(values[i]);
+	}
+	out += ']';
+    }
+
+    bool writeAll(int fd, const std::string& data){
+	std::size_t sent = 0;
+	while(sent < data.size()){
+	    ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+	    if(n < 0 && errno == EINTR) continue;
+	    if(n <= 0) return false;
+	    sent += static_cast<std::size_t>(n);
+	}
+	return true;
+    }
+}
+
+void SolverServer::respond(std::string_view line, std::string& out, cross::CrossCache* cache){
+    line = trim(line);
+    if(line == "ping"){
+	out += "{\"ok\":true}";
+	return;
+    }
+    if(line == "stats"){
+	if(!cache){
+	    error(out, "no cache, start the server with --cache N");
+	    return;
+	}
+	cross::CrossCache::Stats st = cache->stats();
+	out += "{\"ok\":true,\"hits\":" + std::to_string(st.hits) + ",\"misses\":" + std::to_string(st.misses)
+	    + ",\"evictions\":" + std::to_string(st.evictions) + ",\"entries\":" + std::to_string(st.entries)
+	    + ",\"capacity\":" + std::to_string(st.capacity) + "}";
+	return;
+    }
+
+    bool sort = false;
+    bool compact = false;
+    std::string_view metric;
+    std::string_view costSpec;
+    std::size_t bar = line.find('|');
+    if(bar != std::string_view::npos){
+	std::string_view opts = line.substr(0, bar);
+	line = line.substr(bar + 1);
+	while(!opts.empty()){
+	    std::size_t semi = opts.find(';');
+	    std::string_view opt = trim(opts.substr(0, semi));
+	    opts = semi == std::string_view::npos ? std::string_view() : opts.substr(semi + 1);
+	    if(opt.empty()) continue;
+	    if(opt == "sort"){
+		sort = true;
+	    } else if(opt == "table=compact"){
+		compact = true;
+	    } else if(opt == "table=full"){
+		compact = false;
+	    } else if(opt.substr(0, 7) == "metric="){
+		metric = opt.substr(7);
+	    } else if(opt.substr(0, 6) == "costs="){
+		costSpec = opt.substr(6);
+	    } else {
+		error(out, "unknown option " + std::string(opt));
+		return;
+	    }
+	}
+    }
+
+    std::uint8_t codes[MAX_SCRAMBLE_MOVES];
+    ParseResult parsed = parseMoves(line, codes, MAX_SCRAMBLE_MOVES);
+    if(!parsed.ok()){
+	error(out, describeError(parsed, line));
+	return;
+    }
+    cross::EdgeLocations loc = cross::SOLVED_EDGES;
+    cross::applyMoves(loc, codes, parsed.count);
+
+    std::array<std::string, 24> text;
+    std::array<int, 24> lengths;
+    std::array<int, 24> costs;
+    bool weighted = !metric.empty() || !costSpec.empty();
+    if(weighted){
+	cross::MoveCosts mc;
+	if(!cross::metricCosts(metric.empty() ? "htm" : metric, mc)){
+	    error(out, "unknown metric " + std::string(metric));
+	    return;
+	}
+	if(!cross::applyCostOverrides(costSpec, mc)){
+	    error(out, "bad costs " + std::string(costSpec));
+	    return;
+	}
+	std::array<cross::WeightedCrossSolver::Result, 24> res = cross::WeightedCrossSolver(mc).solveAll(loc);
+	for(const cross::WeightedCrossSolver::Result& r : res){
+	    if(r.truncated){
+		error(out, "cheapest cross is longer than " + std::to_string(r.moves.moves.size()) + " moves under these costs");
+		return;
+	    }
+	}
+	for(int i = 0; i < 24; i++){
+	    text[i] = moves::toString(res[i].moves);
+	    lengths[i] = res[i].moves.length;
+	    costs[i] = res[i].cost;
+	}
+    } else if(compact){
+	SweepSequences seqs = sweepOrientationsCompact(loc);
+	for(int i = 0; i < 24; i++){
+	    text[i] = moves::toString(seqs[i]);
+	    lengths[i] = seqs[i].length;
+	}
+    } else {
+	SweepResult sols = cache ? cache->solve(loc) : sweepOrientations(loc);
+	for(int i = 0; i < 24; i++){
+	    text[i] = std::string(sols[i]);
+	    lengths[i] = numMoves(sols[i]);
+	}
+    }
+
+    // a negative cost means the move set can't solve that orientation at all
+    const std::array<int, 24>& key = weighted ? costs : lengths;
+    int best = -1;
+    for(int k : key){
+	if(k >= 0 && (best < 0 || k < best)) best = k;
+    }
+    if(best < 0){
+	error(out, "no orientation is solvable with these costs");
+	return;
+    }
+    out += "{\"ok\":true,\"best\":";
+    out += std::to_string(best);
+    out += ",\"solutions\":[";
+    for(int i = 0; i < 24; i++){
+	if(i > 0) out += ',';
+	out += '"';
+	out += text[i];
+	out += '"';
+    }
+    out += ']';
+    appendList(out, "lengths", lengths);
+    if(weighted) appendList(out, "costs", costs);
+    if(sort){
+	std::array<int, 24> order;
+	for(int i = 0; i < 24; i++) order[i] = i;
+	// unsolvable orientations go last
+	std::stable_sort(order.begin(), order.end(), [&](int a, int b){
+	    return static_cast<unsigned>(key[a]) < static_cast<unsigned>(key[b]);
+	});
+	appendList(out, "order", order);
+    }
+    out += '}';
+}
+
+SolverServer::SolverServer(std::string path, unsigned threads, cross::CrossCache* cache)
+    : path_(std::move(path)), threads_(threads == 0 ? 1 : threads), cache_(cache) {}
+
+SolverServer::~SolverServer(){
+    if(listenFd_ >= 0) ::close(listenFd_);
+}
+
+bool SolverServer::start(std::string& err){
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if(path_.size() >= sizeof(addr.sun_path)){
+	err = "socket path too long: " + path_;
+	return false;
+    }
+    std::memcpy(addr.sun_path, path_.c_str(), path_.size() + 1);
+
+    listenFd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if(listenFd_ < 0){
+	err = std::string("socket: ") + std::strerror(errno);
+	return false;
+    }
+    // a socket file left behind by a previous run would make bind fail; anything else at the path is not ours
+    struct stat st;
+    if(::lstat(path_.c_str(), &st) == 0){
+	if(!S_ISSOCK(st.st_mode)){
+	    err = path_ + " exists and is not a socket";
+	    ::close(listenFd_);
+	    listenFd_ = -1;
+	    return false;
+	}
+	int probe = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	bool live = probe >= 0 && ::connect(probe, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0;
+	if(probe >= 0) ::close(probe);
+	if(live){
+	    err = "another server is already listening on " + path_;
+	    ::close(listenFd_);
+	    listenFd_ = -1;
+	    return false;
+	}
+	::unlink(path_.c_str());
+    }
+    if(::bind(listenFd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0){
+	err = "cannot listen on " + path_ + ": " + std::strerror(errno);
+	::close(listenFd_);
+	listenFd_ = -1;
+	return false;
+    }
+    bound_ = true;
+    if(::listen(listenFd_, 128) != 0){
+	err = "cannot listen on " + path_ + ": " + std::strerror(errno);
+	::close(listenFd_);
+	listenFd_ = -1;
+	::unlink(path_.c_str());
+	bound_ = false;
+	return false;
+    }
+
+    // page the tables in before the first client is waiting on them
+    std::string warm;
+    respond("R U F", warm);
+
+    for(unsigned i = 0; i < threads_; i++) pool_.emplace_back(&SolverServer::worker_, this);
+    return true;
+}
+
+void SolverServer::run(){
+    while(!stopping_.load()){
+	int fd = ::accept4(listenFd_, nullptr, nullptr, SOCK_CLOEXEC);
+	if(fd < 0){
+	    if(errno == EINTR && !stopping_.load()) continue;
+	    if(stopping_.load()) break;
+	    continue;
+	}
+	{
+	    std::lock_guard<std::mutex> lock(mtx_);
+	    clients_.push_back(fd);
+	}
+	ready_.notify_one();
+    }
+
+    {
+	std::lock_guard<std::mutex> lock(mtx_);
+	stopping_.store(true);
+	for(int fd : active_) ::shutdown(fd, SHUT_RDWR);
+	for(int fd : clients_) ::close(fd);
+	clients_.clear();
+    }
+    ready_.notify_all();
+    for(std::thread& t : pool_) t.join();
+    pool_.clear();
+    if(bound_) ::unlink(path_.c_str());
+    bound_ = false;
+}
+
+void SolverServer::stop(){
+    stopping_.store(true);
+    if(listenFd_ >= 0) ::shutdown(listenFd_, SHUT_RDWR);
+}
+
+void SolverServer::worker_(){
+    for(;;){
+	int fd;
+	{
+	    std::unique_lock<std::mutex> lock(mtx_);
+	    ready_.wait(lock, [&]{ return !clients_.empty() || stopping_.load(); });
+	    if(clients_.empty()) return;
+	    fd = clients_.front();
+	    clients_.pop_front();
+	    active_.push_back(fd);
+	}
+	serveClient_(fd);
+	{
+	    std::lock_guard<std::mutex> lock(mtx_);
+	    active_.erase(std::find(active_.begin(), active_.end(), fd));
+	}
+	::close(fd);
+    }
+}
+
+void SolverServer::serveClient_(int fd){
+    std::string pending;
+    std::string replies;
+    char buf[16384];
+    bool skipping = false;	//inside a line that was already too long
+
+    while(!stopping_.load()){
+	ssize_t n = ::recv(fd, buf, sizeof(buf), 0);
+	if(n < 0 && errno == EINTR) continue;
+	if(n <= 0) return;
+	pending.append(buf, static_cast<std::size_t>(n));
+
+	// answer every complete line in this read with one write, pipelined clients get batched replies
+	std::size_t start = 0;
+	for(std::size_t nl; (nl = pending.find('\n', start)) != std::string::npos; start = nl + 1){
+	    if(skipping){
+		skipping = false;
+		continue;
+	    }
+	    if(nl - start > kMaxLine){
+		error(replies, "line too long");
+	    } else {
+		respond(std::string_view(pending).substr(start, nl - start), replies, cache_);
+	    }
+	    replies += '\n';
+	}
+	pending.erase(0, start);
+	if(pending.size() > kMaxLine && !skipping){
+	    error(replies, "line too long");
+	    replies += '\n';
+	    pending.clear();
+	    skipping = true;
+	} else if(skipping){
+	    pending.clear();
+	}
+
+	if(!replies.empty()){
+	    if(!writeAll(fd, replies)) return;
+	    replies.clear();
+	}
+    }
+}
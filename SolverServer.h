@@ -0,0 +1,79 @@
+#ifndef SOLVER_SERVER_H
+#define SOLVER_SERVER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace cross {
+    class CrossCache;
+}
+
+/*
+ * Keeps the tables hot and answers cross requests on a Unix domain socket.
+ *
+ * Every line a client sends is one request, every request gets one line
+ * back, in order:
+ *
+ *   [options|]scramble
+ *
+ * options are ';' separated: sort, table=full|compact, metric=htm|qtm|stm,
+ * costs=SPEC (same as the command line). "ping" answers {"ok":true},
+ * "stats" the result cache counters when the server has one:
+ *
+ *   {"ok":true,"hits":12,"misses":3,"evictions":0,"entries":3,"capacity":65536}
+ *
+ * Replies are compact JSON:
+ *
+ *   {"ok":true,"best":5,"solutions":["R U F'",...],"lengths":[3,...]}
+ *
+ * with solutions in cross::ORIENTATIONS order, plus "costs" under a metric
+ * and "order" (orientations cheapest first) with sort. Errors come back as
+ * {"ok":false,"error":"..."}.
+ *
+ * Plain full-table requests go through the cache, which every connection
+ * shares. Accepted connections are queued for a fixed pool of worker threads, each
+ * serving one connection at a time until the client hangs up.
+ */
+class SolverServer {
+private:
+    std::string path_;
+    unsigned threads_;
+    cross::CrossCache* cache_;
+    int listenFd_ = -1;
+    bool bound_ = false;	//the socket file at path_ is ours to remove
+    std::atomic<bool> stopping_{false};
+
+    std::mutex mtx_;
+    std::condition_variable ready_;
+    std::deque<int> clients_;	//accepted, waiting for a worker
+    std::vector<int> active_;	//being served, shut down on stop so idle clients don't hold a worker
+    std::vector<std::thread> pool_;
+
+    void worker_();
+    void serveClient_(int fd);
+
+public:
+    //Constructor, the cache (may be null) must outlive the server
+    SolverServer(std::string path, unsigned threads, cross::CrossCache* cache = nullptr);
+    ~SolverServer();
+
+    //Binds and listens (replacing a stale socket file), false with the reason in `error`
+    bool start(std::string& error);
+
+    //Accept loop, returns after stop()
+    void run();
+
+    //Safe to call from a signal handler
+    void stop();
+
+    //One request line to one reply line (no newline), also what the client tests against
+    static void respond(std::string_view line, std::string& out, cross::CrossCache* cache = nullptr);
+};
+
+#endif
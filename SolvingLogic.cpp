@@ -1,10 +1,20 @@
+#include <memory>
 #include <string_view>
 #include <unordered_map>
 
 #include "SolvingLogic.h"
 #include "Cube.h"
 #include "CrossConstants.hpp"
+#include "CrossDistance.h"
+#include "CrossTableFile.h"
+#ifndef CROSS_NO_EMBEDDED_TABLE
 #include "CrossTable.generated.hpp"
+#endif
+
+namespace {
+    // set once at startup, before lookups run on other threads
+    std::unique_ptr<cross::MappedCrossTable> mappedTable;
+}
 
 SolvingLogic::SolvingLogic(Cube& c) : cube(c) {}
 
@@ -65,21 +75,65 @@ std::array<int, 4> SolvingLogic::getCrossLocations() {
     return res;
 }
 
+/*
+ * The cross edges are the DF, DR, DB and DL pieces (edge slots 8, 11, 10, 9)
+ * and their reference sticker is the down one, so the location is just
+ * 2 * slot + flip of wherever the piece is now.
+ */
+std::array<int, 4> SolvingLogic::getCrossLocations(const CubieCube& cc) {
+    std::array<std::uint8_t, 12> loc = cc.edgeLocations();
+    return {loc[8], loc[11], loc[10], loc[9]};
+}
+
 std::size_t SolvingLogic::crossIndex_(uint8_t F, uint8_t L, uint8_t B, uint8_t R) noexcept {
-  return F + cross_table::kBase * (L + cross_table::kBase * (B + cross_table::kBase * R));
+  return F + cross::BASE * (L + cross::BASE * (B + cross::BASE * R));
 }
 
 std::string_view SolvingLogic::lookupFLBR_(uint8_t F, uint8_t L, uint8_t B, uint8_t R) noexcept {
-  auto idx = crossIndex_(F, L, B, R);
+  return getCrossSolutionAt(crossIndex_(F, L, B, R));
+}
+
+std::string_view SolvingLogic::getCrossSolutionAt(std::size_t idx) noexcept {
+  if (mappedTable) return mappedTable->lookup(idx);
+#ifndef CROSS_NO_EMBEDDED_TABLE
   int entry = cross_table::kIndex[idx];
   if (entry < 0) return {}; // no moves needed or missing
   const auto &e = cross_table::kEntries[static_cast<std::size_t>(entry)];
   return std::string_view{cross_table::kMovesBlob + e.str_offset, e.str_len};
+#else
+  return {};
+#endif
+}
+
+std::string_view SolvingLogic::getCrossSolution(const std::array<int, 4>& pos) noexcept {
+    return lookupFLBR_(static_cast<uint8_t>(pos[0]), static_cast<uint8_t>(pos[1]), static_cast<uint8_t>(pos[2]), static_cast<uint8_t>(pos[3]));
 }
 
 std::string SolvingLogic::getCrossSolutions(const std::array<int, 4>& pos) {
-    std::string_view sv = lookupFLBR_(static_cast<uint8_t>(pos[0]), static_cast<uint8_t>(pos[1]), static_cast<uint8_t>(pos[2]), static_cast<uint8_t>(pos[3]));
-    std::string str(sv);
+    std::string str(getCrossSolution(pos));
     return str;
 }
 
+std::size_t SolvingLogic::tableBytes() noexcept {
+    if (mappedTable) return mappedTable->bytes();
+#ifndef CROSS_NO_EMBEDDED_TABLE
+    return sizeof(cross_table::kIndex) + sizeof(cross_table::kEntries) + sizeof(cross_table::kMovesBlob);
+#else
+    return 0;
+#endif
+}
+
+bool SolvingLogic::useTableFile(const std::string& path, std::string& error, bool verify) {
+    std::unique_ptr<cross::MappedCrossTable> t = cross::MappedCrossTable::open(path, error, verify);
+    if (!t) return false;
+    mappedTable = std::move(t);
+    return true;
+}
+
+bool SolvingLogic::hasTable() noexcept {
+#ifndef CROSS_NO_EMBEDDED_TABLE
+    return true;
+#else
+    return mappedTable != nullptr;
+#endif
+}
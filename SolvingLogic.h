@@ -1,7 +1,12 @@
 #ifndef SOLVING_LOGIC_H
 #define SOLVING_LOGIC_H
 
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
 #include "Cube.h"
+#include "CubieCube.h"
 
 class SolvingLogic {
 private:
@@ -16,7 +21,19 @@ public:
 
    bool isSolved() const;
    std::array<int, 4> getCrossLocations();
+   static std::array<int, 4> getCrossLocations(const CubieCube& cc);	//same result, read from pieces instead of stickers
    std::string getCrossSolutions(const std::array<int, 4>& positions);
+   static std::string_view getCrossSolution(const std::array<int, 4>& positions) noexcept;	//view into the static table
+   static std::string_view getCrossSolutionAt(std::size_t index) noexcept;	//same, by base-24 cross index
+   static std::size_t tableBytes() noexcept;	//index + entries + move text
+
+   /*
+    * Answer from a table file (see CrossTableFile.h) instead of the compiled-in
+    * table. Call before any lookups start; on failure the compiled-in table
+    * stays in use and the reason is in `error`.
+    */
+   static bool useTableFile(const std::string& path, std::string& error, bool verify = false);
+   static bool hasTable() noexcept;
 };
 
 #endif
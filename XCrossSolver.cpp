@@ -0,0 +1,98 @@
+#include "XCrossSolver.h"
+#include "CrossConstants.hpp"
+#include "CrossCoords.h"
+#include "CrossDistance.h"
+#include "DistanceTable.h"
+#include "FrameSweep.h"
+#include "IdaSearch.h"
+
+namespace {
+
+    // DFR corner and FR edge, solved
+    constexpr std::uint8_t SLOT_CORNER = 4;
+    constexpr std::uint8_t SLOT_EDGE = 4;
+    constexpr std::size_t STATES = cross::STATES * 24;
+
+    // longest optimal X-cross is well below this
+    constexpr int MAX_DEPTH = 16;
+
+    struct State {
+	std::array<int, 4> cross;
+	std::uint8_t corner;
+	std::uint8_t edge;
+    };
+
+    std::vector<std::uint8_t> buildTable(const cross::MoveTable& pieceMoves, std::uint8_t goal, unsigned threads){
+	const cross::MoveTable& edgeMoves = cross::edgeMoveTable();
+	auto next = [&](std::size_t idx, int m){
+	    std::array<int, 4> pos = cross::applyMove(cross::unpackIndex(idx / 24), m, edgeMoves);
+	    return cross::packIndex(pos) * 24 + pieceMoves[idx % 24][m];
+	};
+	return dist::bfs(STATES, {cross::SOLVED_INDEX * 24 + goal}, moves::COUNT, next, threads);
+    }
+}
+
+XCrossSolver::XCrossSolver(const std::string& tableDir, unsigned threads) {
+    crossCorner_ = dist::loadOrBuild(tableDir, "xcross-corner", STATES, [&]{ return buildTable(cross::cornerMoveTable(), 3 * SLOT_CORNER, threads); });
+    crossEdge_ = dist::loadOrBuild(tableDir, "xcross-edge", STATES, [&]{ return buildTable(cross::edgeMoveTable(), 2 * SLOT_EDGE, threads); });
+
+    const auto& tables = cross::orientationTables();
+    for(int o = 0; o < 24; o++){
+	for(int k = 0; k < 4; k++){
+	    int piece = tables[o].physical[2 * (SLOT_EDGE + k)] >> 1;
+	    for(int f = 0; f < 24; f++){
+		if(cross::ORIENTATIONS[f].first == cross::ORIENTATIONS[o].first && (tables[f].physical[2 * SLOT_EDGE] >> 1) == piece){
+		    slotFrame_[o][k] = static_cast<std::uint8_t>(f);
+		}
+	    }
+	}
+    }
+}
+
+moves::Sequence XCrossSolver::solve(const cross::EdgeLocations& edges, const cross::CornerLocations& corners) const {
+    const cross::MoveTable& edgeMoves = cross::edgeMoveTable();
+    const cross::MoveTable& cornerMoves = cross::cornerMoveTable();
+    const std::uint8_t* cc = crossCorner_.data();
+    const std::uint8_t* ce = crossEdge_.data();
+
+    auto h = [&](const State& s){
+	std::size_t idx = cross::packIndex(s.cross) * 24;
+	int a = cc[idx + s.corner];
+	int b = ce[idx + s.edge];
+	return a > b ? a : b;
+    };
+    auto apply = [&](const State& s, int m){
+	return State{cross::applyMove(s.cross, m, edgeMoves), cornerMoves[s.corner][m], edgeMoves[s.edge][m]};
+    };
+
+    State start{{edges[8], edges[11], edges[10], edges[9]}, corners[SLOT_CORNER], edges[SLOT_EDGE]};
+    moves::Sequence sol;
+    ida::solve(start, MAX_DEPTH, h, apply, sol);
+    return sol;
+}
+
+std::array<XCrossSolver::SlotSolutions, 24> XCrossSolver::solveAll(const cross::EdgeLocations& edges, const cross::CornerLocations& corners, unsigned threads) const {
+    const auto& tables = cross::orientationTables();
+
+    // one search per orientation, each solving that frame's front-right slot
+    std::array<moves::Sequence, 24> frontRight = cross::sweepFrames<moves::Sequence>(edges, corners, threads, [&](const cross::EdgeLocations& e, const cross::CornerLocations& c){
+	return solve(e, c);
+    });
+
+    std::array<SlotSolutions, 24> res;
+    for(int o = 0; o < 24; o++){
+	for(int k = 0; k < 4; k++){
+	    int from = slotFrame_[o][k];
+	    moves::Sequence seq = frontRight[from];
+	    for(int i = 0; i < seq.length; i++){
+		seq.moves[i] = static_cast<std::uint8_t>(cross::frameMove(cross::physicalMove(seq.moves[i], tables[from]), tables[o]));
+	    }
+	    res[o][k] = seq;
+	}
+    }
+    return res;
+}
+
+std::array<XCrossSolver::SlotSolutions, 24> XCrossSolver::solveAll(const CubieCube& cc, unsigned threads) const {
+    return solveAll(cc.edgeLocations(), cc.cornerLocations(), threads);
+}
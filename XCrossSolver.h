@@ -0,0 +1,44 @@
+#ifndef XCROSS_SOLVER_H
+#define XCROSS_SOLVER_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "CrossSymmetry.h"
+#include "CubieCube.h"
+#include "Moves.h"
+
+/*
+ * Optimal X-cross (cross plus one solved F2L pair) by IDA*.
+ *
+ * The search state is the cross coordinate from SolvingLogic plus the
+ * position of one corner and one edge. It is pruned with two tables over
+ * (cross x corner) and (cross x edge) for the front-right slot, 24^5 bytes
+ * each. Any other slot / orientation is the front-right slot of some entry
+ * in cross::ORIENTATIONS, so every (Down, Front, slot) case comes from the
+ * 24 front-right searches translated into the asking frame.
+ */
+class XCrossSolver {
+public:
+    enum Slot { FR = 0, FL, BL, BR };
+    using SlotSolutions = std::array<moves::Sequence, 4>;	//indexed by Slot, moves in that orientation's frame
+
+    //Constructor: loads the pruning tables from tableDir, building (and saving) them when missing
+    explicit XCrossSolver(const std::string& tableDir = "", unsigned threads = 1);
+
+    //One entry per cross::ORIENTATIONS, the 24 searches spread over `threads`
+    std::array<SlotSolutions, 24> solveAll(const CubieCube& cc, unsigned threads = 1) const;
+    std::array<SlotSolutions, 24> solveAll(const cross::EdgeLocations& edges, const cross::CornerLocations& corners, unsigned threads = 1) const;
+
+    //Front-right X-cross of a state already expressed in the frame to solve in
+    moves::Sequence solve(const cross::EdgeLocations& edges, const cross::CornerLocations& corners) const;
+
+private:
+    std::vector<std::uint8_t> crossCorner_;
+    std::vector<std::uint8_t> crossEdge_;
+    //slotFrame_[o][k]: orientation whose front-right slot is slot k of orientation o
+    std::array<std::array<std::uint8_t, 4>, 24> slotFrame_;
+};
+
+#endif
@@ -1,140 +1,777 @@
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <csignal>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <iomanip>
+#include <memory>
+#include <optional>
+#include <random>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <thread>
+#include "BatchRunner.h"
+#include "CompactCrossTable.h"
+#include "CrossCache.h"
+#include "CrossConstants.hpp"
+#include "CrossDistance.h"
+#include "CrossEnumerator.h"
+#include "CrossMetric.h"
+#include "CrossRecordFile.h"
+#include "CrossStatistics.h"
+#include "CrossSweep.h"
 #include "Cube.h"
 #include "CubeManipulator.h"
+#include "CubieCube.h"
+#include "DrillGenerator.h"
+#include "EOCrossSolver.h"
+#include "F2LPairs.h"
+#include "MoveParser.h"
+#include "Moves.h"
+#include "PetrusBlockSolver.h"
+#include "RouxBlockSolver.h"
+#include "SolutionPrinter.h"
+#include "SolverServer.h"
 #include "SolvingLogic.h"
+#include "XCrossSolver.h"
 
-std::array<std::pair<Face, Face>, 24> faces = {{
-    {Face::UP, Face::RIGHT},
-    {Face::UP, Face::BACK},
-    {Face::UP, Face::LEFT},
-    {Face::UP, Face::FRONT},
-    {Face::DOWN, Face::RIGHT},
-    {Face::DOWN, Face::BACK},
-    {Face::DOWN, Face::LEFT},
-    {Face::DOWN, Face::FRONT},
-    {Face::RIGHT, Face::UP},
-    {Face::RIGHT, Face::BACK},
-    {Face::RIGHT, Face::DOWN},
-    {Face::RIGHT, Face::FRONT},
-    {Face::LEFT, Face::UP},
-    {Face::LEFT, Face::BACK},
-    {Face::LEFT, Face::DOWN},
-    {Face::LEFT, Face::FRONT},
-    {Face::BACK, Face::UP},
-    {Face::BACK, Face::LEFT},
-    {Face::BACK, Face::DOWN},
-    {Face::BACK, Face::RIGHT},
-    {Face::FRONT, Face::UP},
-    {Face::FRONT, Face::LEFT},
-    {Face::FRONT, Face::DOWN},
-    {Face::FRONT, Face::RIGHT}
-}}; 
-
-bool validMove(char move){
-    return move == 'R' || move == 'U' || move == 'D' || move == 'L' || move == 'F' || move == 'B';
-}
-std::vector<std::string> parseMoveString(std::string& moves){
-    std::vector<std::string> parsedMoves;
-    int n = moves.length(); 
-    
-    for(int i = 0; i < n; i++){
-	if(!validMove(moves[i])) continue;
-	if(i + 1 < n && (moves[i + 1] == '\'' || moves[i + 1] == '2')){
-	    parsedMoves.push_back(moves.substr(i, 2)); 
-	    i++;
-	    continue;
-	}
-	parsedMoves.push_back(moves.substr(i, 1)); 
-    }
-    return parsedMoves;
+struct Options {
+    bool batch = false;
+    bool xcross = false;
+    std::optional<EOCrossSolver::Goal> eoGoal;	//--eocross / --eoline
+    bool roux = false;
+    bool petrus = false;
+    bool toRecords = false;
+    bool fromRecords = false;
+    bool listAll = false;
+    bool sort = false;
+    bool f2l = false;
+    bool compact = false;
+    bool compareTables = false;
+    bool verifyTable = false;
+    bool timing = false;
+    int drillDepth = -1;
+    std::size_t drillCount = 1;
+    std::uint64_t seed = std::random_device{}();
+    std::string colour = "cn";
+    bool stats = false;
+    std::string checkpoint;
+    double checkpointSeconds = 60.0;
+    std::size_t stopAfter = 0;
+    double tableSetupUs = 0.0;	//main() start until the cross table is usable
+    int slack = 0;
+    std::size_t limit = 10000;	//--all lists at most this many solutions per orientation
+    unsigned threads = std::thread::hardware_concurrency();
+    std::string batchPath;
+    std::string recordsPath;	//input of --to-records / --from-records, stdin when empty or "-"
+    std::string tableDir;
+    std::string metric;
+    std::string costs;
+    std::string tableFile;
+    std::string servePath;
+    OutputFormat format = OutputFormat::TEXT;
+    bool net = true;
+    std::size_t cacheEntries = 0;
+    bool cacheSymmetric = false;
+};
+
+void printUsage(const char* prog){
+    std::cerr << "usage: " << prog << "                      read one scramble and print every orientation" << std::endl;
+    std::cerr << "       " << prog << " --batch [FILE|-]     solve one scramble per line (default stdin)" << std::endl;
+    std::cerr << "       " << prog << " --xcross             optimal X-cross for every orientation and slot" << std::endl;
+    std::cerr << "       " << prog << " --eocross            optimal ZZ EOCross for every orientation (--eoline: EOLine)" << std::endl;
+    std::cerr << "       " << prog << " --roux               optimal Roux first block for every orientation and side" << std::endl;
+    std::cerr << "       " << prog << " --petrus             optimal 2x2x2 around every corner and 2x2x3 extending it" << std::endl;
+    std::cerr << "       " << prog << " --to-records [FILE|-] scrambles (one per line) to binary records on stdout" << std::endl;
+    std::cerr << "       " << prog << " --from-records [FILE|-] binary records back to --format rows (default tsv)" << std::endl;
+    std::cerr << "       " << prog << " --drill N            scrambles whose optimal cross is exactly N moves" << std::endl;
+    std::cerr << "       " << prog << " --stats              exact colour-neutral cross statistics over every edge state (hours)" << std::endl;
+    std::cerr << "       " << prog << " --serve SOCKET       answer requests on a Unix socket until SIGINT/SIGTERM (see cross-client)" << std::endl;
+    std::cerr << "options (--all, --metric, --costs, --sort and --f2l for a single scramble only):" << std::endl;
+    std::cerr << "  --all          list every optimal cross per orientation, not just one (text format only)" << std::endl;
+    std::cerr << "  --slack N      with --all, also list solutions up to N moves over optimal" << std::endl;
+    std::cerr << "  --limit N      with --all, list at most N solutions per orientation (default 10000)" << std::endl;
+    std::cerr << "  --metric M     cheapest cross under htm, qtm or stm instead of the table" << std::endl;
+    std::cerr << "  --costs SPEC   per-move costs on top of the metric, e.g. \"B=2,B'=2,D'=3,B2=x\"" << std::endl;
+    std::cerr << "  --sort         print orientations cheapest first" << std::endl;
+    std::cerr << "  --f2l          among equally short crosses prefer the F2L pairs they leave, and rank by that" << std::endl;
+    std::cerr << "  --format F     text (default), json, csv, compact or tsv (--batch default: tsv)" << std::endl;
+    std::cerr << "  --no-net       text format without the cube nets" << std::endl;
+    std::cerr << "  --table T      full (default) or compact 4-bit distance table" << std::endl;
+    std::cerr << "  --table-file F  map the cross table from F (default: $CROSS_SOLVER_TABLE, else compiled in)" << std::endl;
+    std::cerr << "  --verify-table  check the table file's data checksum before using it" << std::endl;
+    std::cerr << "  --timing       report table setup and first solve time on stderr" << std::endl;
+    std::cerr << "  --compare-tables  memory and lookup time of both cross tables" << std::endl;
+    std::cerr << "  --color C      with --drill, cross colour W Y R O G B, or cn for best of six (default cn)" << std::endl;
+    std::cerr << "  --count K      with --drill, how many scrambles (default 1)" << std::endl;
+    std::cerr << "  --seed S       with --drill, random seed (default: random)" << std::endl;
+    std::cerr << "  --checkpoint F with --stats, save progress to F every --checkpoint-every seconds (default 60) and resume from it" << std::endl;
+    std::cerr << "  --stop-after N with --stats, stop after N more Down cross classes" << std::endl;
+    std::cerr << "  --cache N      with --serve, remember the sweeps of up to N edge states (full table only)" << std::endl;
+    std::cerr << "  --cache-symmetric  with --cache, one entry for a state and its 24 whole-cube rotations" << std::endl;
+    std::cerr << "  --threads N    worker threads for --batch / --xcross / --eocross / --serve (default: all cores)" << std::endl;
+    std::cerr << "  --tables DIR   load pruning tables from DIR, saving them there on first build" << std::endl;
 }
 
-void printMoveString(const std::vector<std::string>& moves){
-    int n = moves.size();
-    for(int i = 0; i < n; i++){
-	std::cout << moves[i] << " ";
+// prompts for one scramble line, pointing at the first thing that isn't a move
+bool readScramble(std::string& scramble, std::array<std::uint8_t, MAX_SCRAMBLE_MOVES>& buf, std::size_t& count, bool prompt){
+    if(prompt) std::cout << "Input Scramble: " << std::flush;
+    std::getline(std::cin, scramble);
+
+    ParseResult res = parseMoves(scramble, buf.data(), buf.size());
+    if(!res.ok()){
+	std::cerr << "bad scramble, " << describeError(res, scramble) << std::endl;
+	std::cerr << "    " << scramble << std::endl;
+	std::cerr << "    " << std::string(res.errorPos, ' ') << "^" << std::endl;
+	return false;
     }
-    std::cout << std::endl;
+    count = res.count;
+    return true;
 }
 
-int numMoves(const std::string& sol){
-    int res = 0;
-    int n = sol.length();
-    for(int i = 0; i < n; i++){
-	if (validMove(sol[i])) ++res;
+// one scramble from stdin straight onto the pieces, for the searching modes
+bool readScrambledCube(CubieCube& cc){
+    std::string scrambleText;
+    std::array<std::uint8_t, MAX_SCRAMBLE_MOVES> scramble;
+    std::size_t scrambleLength = 0;
+    if(!readScramble(scrambleText, scramble, scrambleLength, true)) return false;
+    for(std::size_t i = 0; i < scrambleLength; i++){
+	cc.applyMove(scramble[i]);
     }
-    return res;
+    return true;
 }
 
-std::string getOrientation(Cube c){
-
-    char f = c.getColorAtPosition(Face::FRONT, 1, 1);
-    char d = c.getColorAtPosition(Face::DOWN, 1, 1);
-
-    std::string front;
-    std::string down;
+// f() and how long it took, table setup is left out by the callers
+template <typename F>
+auto timedSweep(double& ms, F f){
+    auto start = std::chrono::steady_clock::now();
+    auto res = f();
+    ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return res;
+}
 
-    if(f == 'W') front = "White";
-    if(d == 'W') down = "White";
-    if(f == 'R') front = "Red";
-    if(d == 'R') down = "Red";
-    if(f == 'B') front = "Blue";
-    if(d == 'B') down = "Blue";
-    if(f == 'G') front = "Green";
-    if(d == 'G') down = "Green";
-    if(f == 'O') front = "Orange";
-    if(d == 'O') down = "Orange";
-    if(f == 'Y') front = "Yellow";
-    if(d == 'Y') down = "Yellow";
+/*
+ * One row per orientation, then the shortest ("Best <name>"). The sweep
+ * time goes to stderr so stdout stays comparable between runs.
+ */
+void printFrameSweep(const std::array<moves::Sequence, 24>& res, const std::string& (*label)(int), const std::string& name, double ms){
+    int best = 0;
+    for(int i = 0; i < 24; i++){
+	std::cout << "Solution: " << std::setw(40) << std::left << moves::toString(res[i]) << std::setw(45) << label(i)
+		  << "Move Count: " << static_cast<int>(res[i].length) << std::endl;
+	if(res[i].length < res[best].length) best = i;
+    }
+    std::cout << std::endl << "Best " << name << ": " << label(best) << ": " << moves::toString(res[best])
+	      << " (" << static_cast<int>(res[best].length) << " moves)" << std::endl;
+    std::cerr << name << " sweep: " << std::fixed << std::setprecision(1) << ms << " ms" << std::endl;
+}
 
-    return down + " Cross, " + front + " in front";
+/*
+ * --f2l: every orientation keeps whichever of its optimal crosses leaves the
+ * best F2L pairs (the table's own solution unless another is strictly
+ * better), then rows are ranked by length, or cost, and that score.
+ */
+void rankByF2L(std::vector<SolutionRow>& rows, const cross::EdgeLocations& edges, const cross::CornerLocations& corners, bool repick){
+    Alternatives optimal;
+    if(repick) optimal = CrossEnumerator().enumerateAll(edges, 0);
+    for(SolutionRow& row : rows){
+	moves::Sequence seq;
+	seq.length = static_cast<std::uint8_t>(parseMoves(row.moves, seq.moves.data(), seq.moves.size()).count);
+	row.pairs = cross::pairsAfter(edges, corners, row.orientation, seq);
+	row.f2l = cross::f2lScore(row.pairs);
+	if(!repick) continue;
+	for(const moves::Sequence& alt : optimal[row.orientation]){
+	    cross::PairStates pairs = cross::pairsAfter(edges, corners, row.orientation, alt);
+	    if(alt.length == row.length && cross::f2lScore(pairs) > row.f2l){
+		row.moves = moves::toString(alt);
+		row.pairs = pairs;
+		row.f2l = cross::f2lScore(pairs);
+	    }
+	}
+    }
+    std::stable_sort(rows.begin(), rows.end(), [](const SolutionRow& a, const SolutionRow& b){
+	// unsolvable rows go last
+	auto key = [](const SolutionRow& r){ return r.cost == COST_UNSOLVABLE ? INT_MAX : r.cost >= 0 ? r.cost : r.length; };
+	int ka = key(a);
+	int kb = key(b);
+	return ka != kb ? ka < kb : a.f2l > b.f2l;
+    });
 }
 
-void printSolutions(const std::vector<std::pair<std::string, std::string>>& sol, const Cube& c){
-    int n = sol.size();
-    for(int i = 0; i < n; i++){
-	std::cout << "Solution: " << std::setw(20) << std::left << sol[i].first;
-	std::cout << std::setw(45) << std::left << sol[i].second;
-	Cube temp = c;
-	temp.orient(faces[i].first, faces[i].second);
-	CubeManipulator manip(temp);
-	std::string unparsed_moves = sol[i].first;
-	std::vector<std::string> moves = parseMoveString(unparsed_moves);
-	manip.applyManyMoves(moves);
-	std::cout << "Move Count: " << std::setw(10) << std::left << moves.size() << std::endl;
-	std::cout << "After Cross Solution: " << std::endl << temp << std::endl;
+// --all with --f2l: alternatives shortest first, then best pairs first
+void rankAlternativesByF2L(Alternatives& alts, const cross::EdgeLocations& edges, const cross::CornerLocations& corners){
+    for(int o = 0; o < 24; o++){
+	std::vector<std::pair<int, moves::Sequence>> scored;
+	for(const moves::Sequence& seq : alts[o]) scored.push_back({cross::f2lScore(cross::pairsAfter(edges, corners, o, seq)), seq});
+	std::stable_sort(scored.begin(), scored.end(), [](const auto& a, const auto& b){
+	    return a.second.length != b.second.length ? a.second.length < b.second.length : a.first > b.first;
+	});
+	for(std::size_t i = 0; i < scored.size(); i++) alts[o][i] = scored[i].second;
     }
 }
 
-int main (){
+int runInteractive(const Options& opt){
+
+    bool weighted = !opt.metric.empty() || !opt.costs.empty();
+    cross::MoveCosts costs;
+    if(!cross::metricCosts(opt.metric.empty() ? "htm" : opt.metric, costs)){
+	std::cerr << "unknown metric " << opt.metric << std::endl;
+	return 1;
+    }
+    if(!cross::applyCostOverrides(opt.costs, costs)){
+	std::cerr << "bad --costs spec " << opt.costs << std::endl;
+	return 1;
+    }
 
+    bool text = opt.format == OutputFormat::TEXT;
     Cube c;
     CubeManipulator scrambler(c);
-    std::string scramble;
+    std::string scrambleText;
+    std::array<std::uint8_t, MAX_SCRAMBLE_MOVES> scramble;
+    std::size_t scrambleLength = 0;
+    if(!readScramble(scrambleText, scramble, scrambleLength, text)) return 1;
+    scrambler.applyMoves(scramble.data(), scrambleLength);
 
-    std::cout << "Input Scramble: ";
-    std::getline(std::cin, scramble);
+    BufferedWriter out(std::cout);
+    if(text && opt.net){
+	out.write("Initital State\n\n");
+	appendNet(out.buffer(), c);
+	out.write("\n");
+    }
 
-    std::vector<std::string> parsed_scramble = parseMoveString(scramble);
-    scrambler.applyManyMoves(parsed_scramble);
-    
-    std::cout << "Initital State" << std::endl;
-    std::cout << std::endl << c << std::endl;
-    
-    std::vector<std::pair<std::string, std::string>> solutions;
+    std::vector<SolutionRow> solutions;
+    cross::EdgeLocations edges = cross::edgeLocations(c);
+    std::array<int, 24> order;
+    for(int i = 0; i < 24; i++) order[i] = i;
+
+    if(weighted){
+	cross::WeightedCrossSolver solver(costs);
+	std::array<cross::WeightedCrossSolver::Result, 24> res = solver.solveAll(edges);
+	for(int i = 0; i < 24; i++){
+	    if(res[i].truncated){
+		std::cerr << "the cheapest cross for " << orientationLabel(i) << " is longer than " << res[i].moves.moves.size()
+			  << " moves under these costs" << std::endl;
+		return 1;
+	    }
+	}
+	if(opt.sort) order = cross::WeightedCrossSolver::sortedByCost(res);
+	for(int i : order){
+	    int cost = res[i].cost < 0 ? COST_UNSOLVABLE : res[i].cost;
+	    solutions.push_back({moves::toString(res[i].moves), orientationLabel(i), i, cost, res[i].moves.length});
+	}
+    } else if(opt.compact){
+	SweepSequences seqs = sweepOrientationsCompact(edges);
+	if(opt.sort){
+	    std::stable_sort(order.begin(), order.end(), [&](int a, int b){ return seqs[a].length < seqs[b].length; });
+	}
+	for(int i : order){
+	    solutions.push_back({moves::toString(seqs[i]), orientationLabel(i), i, -1, seqs[i].length});
+	}
+    } else {
+	auto sweepStart = std::chrono::steady_clock::now();
+	SweepResult sols = sweepOrientations(edges);
+	if(opt.timing){
+	    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - sweepStart).count();
+	    std::cerr << "timing: table ready " << std::fixed << std::setprecision(1) << opt.tableSetupUs << " us after start, first sweep " << us << " us" << std::endl;
+	}
+	if(opt.sort){
+	    std::stable_sort(order.begin(), order.end(), [&](int a, int b){ return numMoves(sols[a]) < numMoves(sols[b]); });
+	}
+	for(int i : order){
+	    solutions.push_back({std::string(sols[i]), orientationLabel(i), i, -1, numMoves(sols[i])});
+	}
+    }
     
+    cross::CornerLocations corners = cross::SOLVED_CORNERS;
+    if(opt.f2l){
+	for(std::size_t i = 0; i < scrambleLength; i++) cross::applyMove(corners, scramble[i]);
+	rankByF2L(solutions, edges, corners, !weighted);
+    }
+
+    if(!text){
+	if(opt.format == OutputFormat::CSV) out.write(csvHeader());
+	appendRows(out.buffer(), opt.format, scrambleText, solutions);
+	return 0;
+    }
+    if(opt.listAll){
+	CrossEnumerator enumerator;
+	// one past the limit, so a cut list can be told from one that is exactly that long
+	Alternatives alts = enumerator.enumerateAll(edges, opt.slack, opt.limit + 1);
+	if(opt.f2l) rankAlternativesByF2L(alts, edges, corners);
+	printSolutions(out, solutions, c, &alts, opt.net, opt.limit);
+	return 0;
+    }
+    printSolutions(out, solutions, c, nullptr, opt.net);
+    return 0;
+}
+
+int runXCross(unsigned threads, const std::string& tableDir){
+    CubieCube cc;
+    if(!readScrambledCube(cc)) return 1;
+
+    XCrossSolver solver(tableDir, threads);
+    std::array<XCrossSolver::SlotSolutions, 24> res = solver.solveAll(cc, threads);
+
+    const char* slotNames[4] = {"FR", "FL", "BL", "BR"};
+    Cube c = cc.toCube();
+    int bestO = 0;
+    int bestK = 0;
     for(int i = 0; i < 24; i++){
 	Cube temp = c;
-	SolvingLogic solver(temp);
-	temp.orient(faces[i].first, faces[i].second);
-	std::array<int, 4> pos =  solver.getCrossLocations();
-	std::string sol = solver.getCrossSolutions(pos);
-	std::string orientation = getOrientation(temp);
-	solutions.push_back({sol, orientation});
+	temp.orient(cross::ORIENTATIONS[i].first, cross::ORIENTATIONS[i].second);
+	std::cout << getOrientation(temp) << std::endl;
+	for(int k = 0; k < 4; k++){
+	    std::cout << "    " << slotNames[k] << "  " << std::setw(40) << std::left << moves::toString(res[i][k]);
+	    std::cout << "Move Count: " << static_cast<int>(res[i][k].length) << std::endl;
+	    if(res[i][k].length < res[bestO][bestK].length){
+		bestO = i;
+		bestK = k;
+	    }
+	}
     }
-    
-    printSolutions(solutions, c);
+
+    Cube temp = c;
+    temp.orient(cross::ORIENTATIONS[bestO].first, cross::ORIENTATIONS[bestO].second);
+    std::cout << std::endl << "Best X-Cross: " << getOrientation(temp) << ", " << slotNames[bestK] << " slot: "
+	      << moves::toString(res[bestO][bestK]) << " (" << static_cast<int>(res[bestO][bestK].length) << " moves)" << std::endl;
+    return 0;
+}
+
+int runEOCross(unsigned threads, const std::string& tableDir, EOCrossSolver::Goal goal){
+    CubieCube cc;
+    if(!readScrambledCube(cc)) return 1;
+
+    EOCrossSolver solver(tableDir, threads);
+    double ms = 0.0;
+    std::array<moves::Sequence, 24> res = timedSweep(ms, [&]{ return solver.solveAll(cc, goal, threads); });
+    printFrameSweep(res, orientationLabel, goal == EOCrossSolver::Goal::EOLINE ? "EOLine" : "EOCross", ms);
+    return 0;
+}
+
+int runRoux(unsigned threads, const std::string& tableDir){
+    CubieCube cc;
+    if(!readScrambledCube(cc)) return 1;
+
+    RouxBlockSolver solver(tableDir, threads);
+    double ms = 0.0;
+    std::array<moves::Sequence, 24> res = timedSweep(ms, [&]{ return solver.solveAll(cc, threads); });
+    printFrameSweep(res, blockLabel, "First Block", ms);
+    return 0;
+}
+
+int runPetrus(unsigned threads, const std::string& tableDir){
+    CubieCube cc;
+    if(!readScrambledCube(cc)) return 1;
+
+    PetrusBlockSolver solver(tableDir, threads);
+    double ms = 0.0;
+    PetrusBlockSolver::Blocks res = timedSweep(ms, [&]{ return solver.solveAll(cc, threads); });
+
+    const char* cornerNames[8] = {"URF", "UFL", "ULB", "UBR", "DFR", "DLF", "DBL", "DRB"};
+    const char* edgeNames[12] = {"UF", "UL", "UB", "UR", "FR", "FL", "BL", "BR", "DF", "DL", "DB", "DR"};
+    int bestBlock = 0;
+    int bestExtended = 0;
+    for(int c = 0; c < 8; c++){
+	// the shortest 2x2x3 this block is part of
+	int e = PetrusBlockSolver::extensions(c)[0];
+	for(int k : PetrusBlockSolver::extensions(c)){
+	    if(res.extended[k].length < res.extended[e].length) e = k;
+	}
+	std::cout << cornerNames[c] << "  2x2x2: " << std::setw(30) << std::left << moves::toString(res.block[c])
+		  << "Move Count: " << std::setw(4) << static_cast<int>(res.block[c].length)
+		  << "2x2x3 " << edgeNames[e] << ": " << std::setw(36) << moves::toString(res.extended[e])
+		  << "Move Count: " << static_cast<int>(res.extended[e].length) << std::endl;
+	if(res.block[c].length < res.block[bestBlock].length) bestBlock = c;
+	if(res.extended[e].length < res.extended[bestExtended].length) bestExtended = e;
+    }
+    std::cout << std::endl << "Best 2x2x2: " << cornerNames[bestBlock] << ": " << moves::toString(res.block[bestBlock])
+	      << " (" << static_cast<int>(res.block[bestBlock].length) << " moves)" << std::endl;
+    std::cout << "Best 2x2x3: " << edgeNames[bestExtended] << ": " << moves::toString(res.extended[bestExtended])
+	      << " (" << static_cast<int>(res.extended[bestExtended].length) << " moves)" << std::endl;
+    std::cerr << "Block sweep: " << std::fixed << std::setprecision(1) << ms << " ms" << std::endl;
+    return 0;
+}
+
+/*
+ * Same random sample of cross states through both tables. The full lookup
+ * hands back a view of stored text, the compact one rebuilds the moves.
+ */
+int runTableComparison(){
+    std::vector<std::array<int, 4>> sample;
+    for(std::size_t idx = 0; idx < cross::STATES; idx++){
+	std::uint8_t d = cross::compactDistance(idx);
+	if(d != cross::COMPACT_UNREACHED && d > 0) sample.push_back(cross::unpackIndex(idx));
+    }
+    std::mt19937 rng(12345);
+    std::shuffle(sample.begin(), sample.end(), rng);
+
+    std::size_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for(const std::array<int, 4>& pos : sample) checksum += SolvingLogic::getCrossSolution(pos).size();
+    double fullNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / sample.size();
+
+    start = std::chrono::steady_clock::now();
+    for(const std::array<int, 4>& pos : sample) checksum += cross::compactSolution(pos).length;
+    double compactNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / sample.size();
+
+    start = std::chrono::steady_clock::now();
+    for(const std::array<int, 4>& pos : sample) checksum += cross::compactDistance(cross::packIndex(pos));
+    double distNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / sample.size();
+
+    std::size_t mismatches = 0;
+    for(const std::array<int, 4>& pos : sample){
+	if(moves::toString(cross::compactSolution(pos)) != SolvingLogic::getCrossSolution(pos)) ++mismatches;
+    }
+
+    std::cout << sample.size() << " cross states, random order" << std::endl;
+    std::cout << std::setw(18) << std::left << "table" << std::setw(14) << "bytes" << "ns/lookup" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << std::setw(18) << "full" << std::setw(14) << SolvingLogic::tableBytes() << fullNs << std::endl;
+    std::cout << std::setw(18) << "compact" << std::setw(14) << cross::compactTableBytes() << compactNs << std::endl;
+    std::cout << std::setw(18) << "compact distance" << std::setw(14) << cross::compactTableBytes() << distNs << std::endl;
+    std::cout << "solutions differing: " << mismatches << " (checksum " << checksum << ")" << std::endl;
+    return mismatches == 0 ? 0 : 1;
+}
+
+int runDrill(const Options& opt){
+    int orientation = DrillGenerator::NEUTRAL;
+    if(opt.colour != "cn"){
+	orientation = opt.colour.size() == 1 ? DrillGenerator::orientationForColour(opt.colour[0]) : -1;
+	if(orientation < 0){
+	    std::cerr << "unknown colour " << opt.colour << ", use one of W Y R O G B or cn" << std::endl;
+	    return 1;
+	}
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    DrillGenerator gen(opt.seed);
+    if(!gen.exists(opt.drillDepth, orientation)){
+	std::cerr << "no " << (orientation < 0 ? "colour neutral " : "") << "cross scramble at depth " << opt.drillDepth << " exists" << std::endl;
+	return 1;
+    }
+    std::vector<std::uint8_t> scramble;
+    std::string text;
+    for(std::size_t i = 0; i < opt.drillCount; i++){
+	if(!gen.next(opt.drillDepth, orientation, scramble)){
+	    std::cout << text << std::flush;
+	    std::cerr << "no " << (orientation < 0 ? "colour neutral " : "") << "cross scramble at depth " << opt.drillDepth << " found" << std::endl;
+	    return 1;
+	}
+	for(std::size_t k = 0; k < scramble.size(); k++){
+	    if(k > 0) text += ' ';
+	    text += moves::NAMES[scramble[k]];
+	}
+	text += '\n';
+	if(text.size() >= (1 << 16)){
+	    std::cout << text;
+	    text.clear();
+	}
+    }
+    std::cout << text << std::flush;
+
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cerr << "drill: " << opt.drillCount << " scrambles at depth " << opt.drillDepth << " in " << std::fixed << std::setprecision(3) << secs
+	      << " s (" << std::setprecision(0) << (secs > 0.0 ? opt.drillCount / secs : 0.0) << " scrambles/sec, seed " << opt.seed << ")" << std::endl;
+    return 0;
+}
+
+int runStats(const Options& opt){
+    CrossStatistics stats;
+    CrossStatistics::Histograms totals;
+    std::size_t done = 0;
+    std::cerr << "stats: " << stats.classCount() << " Down cross classes, " << opt.threads << " threads" << std::endl;
+    bool ok = stats.run(opt.threads, opt.checkpoint, opt.checkpointSeconds, opt.stopAfter, totals, done);
+    CrossStatistics::printReport(std::cout, totals, done, stats.classCount());
+    return ok ? 0 : 1;
+}
+
+SolverServer* activeServer = nullptr;
+
+void printCacheStats(const cross::CrossCache& cache){
+    cross::CrossCache::Stats st = cache.stats();
+    std::uint64_t lookups = st.hits + st.misses;
+    double rate = lookups > 0 ? 100.0 * static_cast<double>(st.hits) / static_cast<double>(lookups) : 0.0;
+    std::cerr << "cache: " << st.hits << " hits, " << st.misses << " misses (" << std::fixed << std::setprecision(1) << rate
+	      << "% hit rate), " << st.entries << " of " << st.capacity << " entries, " << st.evictions << " evictions" << std::endl;
+}
+
+void stopServer(int){
+    if(activeServer) activeServer->stop();
+}
+
+int runServer(const Options& opt){
+    std::unique_ptr<cross::CrossCache> cache;
+    if(opt.cacheEntries > 0) cache = std::make_unique<cross::CrossCache>(opt.cacheEntries, opt.cacheSymmetric);
+    SolverServer server(opt.servePath, opt.threads, cache.get());
+    std::string error;
+    if(!server.start(error)){
+	std::cerr << error << std::endl;
+	return 1;
+    }
+    activeServer = &server;
+    struct sigaction sa{};
+    sa.sa_handler = stopServer;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGINT, &sa, nullptr);
+    sigaction(SIGTERM, &sa, nullptr);
+
+    std::cerr << "serving on " << opt.servePath << " with " << opt.threads << " threads (table ready in "
+	      << std::fixed << std::setprecision(0) << opt.tableSetupUs << " us)" << std::endl;
+    server.run();
+    activeServer = nullptr;
+    std::cerr << "server stopped" << std::endl;
+    if(cache) printCacheStats(*cache);
+    return 0;
+}
+
+int runBatchMode(const Options& opt){
+    const std::string& path = opt.batchPath;
+    std::ifstream file;
+    std::istream* in = &std::cin;
+    if(!path.empty() && path != "-"){
+	file.open(path);
+	if(!file){
+	    std::cerr << "cannot open " << path << std::endl;
+	    return 1;
+	}
+	in = &file;
+    }
+
+    std::ios::sync_with_stdio(false);
+    BatchStats stats = runBatch(*in, std::cout, opt.threads, opt.compact, opt.format);
+
+    double rate = stats.seconds > 0.0 ? static_cast<double>(stats.scrambles) / stats.seconds : 0.0;
+    std::cerr << "batch: " << stats.scrambles << " scrambles in " << std::fixed << std::setprecision(3) << stats.seconds
+	      << " s (" << std::setprecision(0) << rate << " scrambles/sec, " << stats.threads << " threads)" << std::endl;
+    return 0;
+}
+
+int runToRecords(const Options& opt){
+    std::ifstream file;
+    std::istream* in = &std::cin;
+    if(!opt.recordsPath.empty() && opt.recordsPath != "-"){
+	file.open(opt.recordsPath);
+	if(!file){
+	    std::cerr << "cannot open " << opt.recordsPath << std::endl;
+	    return 1;
+	}
+	in = &file;
+    }
+
+    std::ios::sync_with_stdio(false);
+    cross::RecordWriter writer(std::cout);
+    cross::ConvertStats stats = cross::convertScrambles(*in, writer);
+    if(!writer.flush()){
+	std::cerr << "could not write records" << std::endl;
+	return 1;
+    }
+    std::cerr << "records: " << stats.records << " written, " << stats.invalid << " invalid" << std::endl;
+    return 0;
+}
+
+/*
+ * Records don't keep the scramble text, so rows are named by record number
+ * ("#1" is the first line that was converted) and the moves come from the table.
+ */
+int runFromRecords(const Options& opt){
+    std::ifstream file;
+    std::istream* in = &std::cin;
+    if(!opt.recordsPath.empty() && opt.recordsPath != "-"){
+	file.open(opt.recordsPath, std::ios::binary);
+	if(!file){
+	    std::cerr << "cannot open " << opt.recordsPath << std::endl;
+	    return 1;
+	}
+	in = &file;
+    }
+
+    std::ios::sync_with_stdio(false);
+    BufferedWriter out(std::cout);
+    if(opt.format == OutputFormat::CSV) out.write(csvHeader());
+    cross::RecordReader reader(*in);
+    cross::CrossRecord r;
+    std::array<RowView, 24> rows;
+    std::size_t n = 0;
+    while(reader.next(r)){
+	std::string name = "#" + std::to_string(++n);
+	if(r.flags & cross::RECORD_INVALID){
+	    appendError(out.buffer(), opt.format, name, cross::recordError(r));
+	} else {
+	    for(int o = 0; o < 24; o++) rows[o] = {SolvingLogic::getCrossSolutionAt(r.solution[o]), o, r.length[o], -1};
+	    appendRecord(out.buffer(), opt.format, name, rows.data(), rows.size());
+	}
+	out.commit();
+    }
+    out.flush();
+    if(!reader.error().empty()){
+	std::cerr << reader.error() << std::endl;
+	return 1;
+    }
+    return 0;
+}
+
+int main (int argc, char** argv){
+
+    auto start = std::chrono::steady_clock::now();
+    Options opt;
+    bool formatGiven = false;
+
+    for(int i = 1; i < argc; i++){
+	std::string_view arg = argv[i];
+	if(arg == "--batch"){
+	    opt.batch = true;
+	    if(i + 1 < argc && (argv[i + 1][0] != '-' || std::string_view(argv[i + 1]) == "-")){
+		opt.batchPath = argv[++i];
+	    }
+	} else if(arg == "--to-records" || arg == "--from-records"){
+	    (arg == "--to-records" ? opt.toRecords : opt.fromRecords) = true;
+	    if(i + 1 < argc && (argv[i + 1][0] != '-' || std::string_view(argv[i + 1]) == "-")){
+		opt.recordsPath = argv[++i];
+	    }
+	} else if(arg == "--all"){
+	    opt.listAll = true;
+	} else if(arg == "--slack" && i + 1 < argc){
+	    opt.slack = std::atoi(argv[++i]);
+	    if(opt.slack < 0){
+		std::cerr << "--slack can't be negative" << std::endl;
+		return 1;
+	    }
+	} else if(arg == "--limit" && i + 1 < argc){
+	    long long limit = std::atoll(argv[++i]);
+	    if(limit < 1){
+		std::cerr << "--limit must be at least 1" << std::endl;
+		return 1;
+	    }
+	    opt.limit = static_cast<std::size_t>(limit);
+	} else if(arg == "--xcross"){
+	    opt.xcross = true;
+	} else if(arg == "--eocross"){
+	    opt.eoGoal = EOCrossSolver::Goal::EOCROSS;
+	} else if(arg == "--eoline"){
+	    opt.eoGoal = EOCrossSolver::Goal::EOLINE;
+	} else if(arg == "--roux"){
+	    opt.roux = true;
+	} else if(arg == "--petrus"){
+	    opt.petrus = true;
+	} else if(arg == "--tables" && i + 1 < argc){
+	    opt.tableDir = argv[++i];
+	} else if(arg == "--metric" && i + 1 < argc){
+	    opt.metric = argv[++i];
+	} else if(arg == "--costs" && i + 1 < argc){
+	    opt.costs = argv[++i];
+	} else if(arg == "--table" && i + 1 < argc){
+	    std::string_view t = argv[++i];
+	    if(t != "full" && t != "compact"){
+		std::cerr << "--table must be full or compact" << std::endl;
+		return 1;
+	    }
+	    opt.compact = (t == "compact");
+	} else if(arg == "--table-file" && i + 1 < argc){
+	    opt.tableFile = argv[++i];
+	} else if(arg == "--verify-table"){
+	    opt.verifyTable = true;
+	} else if(arg == "--drill" && i + 1 < argc){
+	    opt.drillDepth = std::atoi(argv[++i]);
+	    if(opt.drillDepth < 0){
+		std::cerr << "--drill needs a depth of 0 or more" << std::endl;
+		return 1;
+	    }
+	} else if((arg == "--color" || arg == "--colour") && i + 1 < argc){
+	    opt.colour = argv[++i];
+	} else if(arg == "--count" && i + 1 < argc){
+	    opt.drillCount = std::strtoull(argv[++i], nullptr, 10);
+	} else if(arg == "--seed" && i + 1 < argc){
+	    opt.seed = std::strtoull(argv[++i], nullptr, 10);
+	} else if(arg == "--stats"){
+	    opt.stats = true;
+	} else if(arg == "--checkpoint" && i + 1 < argc){
+	    opt.checkpoint = argv[++i];
+	} else if(arg == "--checkpoint-every" && i + 1 < argc){
+	    opt.checkpointSeconds = std::atof(argv[++i]);
+	} else if(arg == "--stop-after" && i + 1 < argc){
+	    opt.stopAfter = std::strtoull(argv[++i], nullptr, 10);
+	} else if(arg == "--serve" && i + 1 < argc){
+	    opt.servePath = argv[++i];
+	} else if(arg == "--timing"){
+	    opt.timing = true;
+	} else if(arg == "--compare-tables"){
+	    opt.compareTables = true;
+	} else if(arg == "--format" && i + 1 < argc){
+	    if(!parseOutputFormat(argv[++i], opt.format)){
+		std::cerr << "--format must be text, json, csv, compact or tsv" << std::endl;
+		return 1;
+	    }
+	    formatGiven = true;
+	} else if(arg == "--no-net"){
+	    opt.net = false;
+	} else if(arg == "--sort"){
+	    opt.sort = true;
+	} else if(arg == "--f2l"){
+	    opt.f2l = true;
+	} else if(arg == "--cache" && i + 1 < argc){
+	    opt.cacheEntries = std::strtoull(argv[++i], nullptr, 10);
+	} else if(arg == "--cache-symmetric"){
+	    opt.cacheSymmetric = true;
+	} else if(arg == "--threads" && i + 1 < argc){
+	    int n = std::atoi(argv[++i]);
+	    if(n <= 0){
+		std::cerr << "--threads needs a positive number" << std::endl;
+		return 1;
+	    }
+	    opt.threads = static_cast<unsigned>(n);
+	} else {
+	    printUsage(argv[0]);
+	    return 1;
+	}
+    }
+
+    // batch lines were always tab separated
+    if((opt.batch || opt.fromRecords) && !formatGiven) opt.format = OutputFormat::TSV;
+    if(opt.listAll && opt.format != OutputFormat::TEXT){
+	std::cerr << "--all only works with --format text" << std::endl;
+	return 1;
+    }
+    // only the single-scramble solve reads these, other modes would silently print plain table solutions
+    bool interactive = !opt.batch && !opt.toRecords && !opt.fromRecords && !opt.xcross && !opt.eoGoal && !opt.roux && !opt.petrus
+		       && opt.drillDepth < 0 && !opt.stats && opt.servePath.empty() && !opt.compareTables;
+    if(!interactive && (!opt.metric.empty() || !opt.costs.empty() || opt.sort || opt.f2l || opt.listAll)){
+	std::cerr << "--metric, --costs, --sort, --f2l and --all only work when solving a single scramble" << std::endl;
+	return 1;
+    }
+    if(opt.servePath.empty() && (opt.cacheEntries > 0 || opt.cacheSymmetric)){
+	std::cerr << "--cache and --cache-symmetric only work with --serve" << std::endl;
+	return 1;
+    }
+
+    if(opt.tableFile.empty()){
+	const char* env = std::getenv("CROSS_SOLVER_TABLE");
+	if(env) opt.tableFile = env;
+    }
+    if(!opt.tableFile.empty()){
+	std::string error;
+	if(!SolvingLogic::useTableFile(opt.tableFile, error, opt.verifyTable)){
+	    std::cerr << error << (SolvingLogic::hasTable() ? ", using the compiled-in table" : "") << std::endl;
+	}
+    }
+    if(!SolvingLogic::hasTable() && !opt.compact){
+	std::cerr << "no cross table: this build has none compiled in, pass --table-file or set CROSS_SOLVER_TABLE" << std::endl;
+	return 1;
+    }
+    opt.tableSetupUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    if(opt.compareTables) return runTableComparison();
+    if(opt.drillDepth >= 0) return runDrill(opt);
+    if(opt.stats) return runStats(opt);
+    if(!opt.servePath.empty()) return runServer(opt);
+    if(opt.batch) return runBatchMode(opt);
+    if(opt.toRecords) return runToRecords(opt);
+    if(opt.fromRecords) return runFromRecords(opt);
+    if(opt.xcross) return runXCross(opt.threads, opt.tableDir);
+    if(opt.eoGoal) return runEOCross(opt.threads, opt.tableDir, *opt.eoGoal);
+    if(opt.roux) return runRoux(opt.threads, opt.tableDir);
+    if(opt.petrus) return runPetrus(opt.threads, opt.tableDir);
+    return runInteractive(opt);
 }